@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Helpers shared by benchmark executables
+
+// Runs given function once and returns elapsed wall time in milliseconds
+template <typename Func> double measureMs(Func&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Prints one result line: benchmark name, variant and elapsed time
+inline void reportResult(const std::string& benchmark, const std::string& variant, double ms)
+{
+    std::cout << benchmark << " | " << variant << " | " << ms << " ms" << std::endl;
+}
@@ -0,0 +1,331 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+#include "RadixHeap.h"
+#include "TopK.h"
+#include "SlidingWindowQuantile.h"
+#include "SplitHeap.h"
+#include "ExternalHeap.h"
+#include "BenchmarkUtils.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+namespace
+{
+
+struct Edge
+{
+    uint32_t target;
+    uint32_t weight;
+};
+
+using Graph = GADS::GenericVector< GADS::GenericVector<Edge> >;
+using Distances = GADS::GenericVector<uint64_t>;
+
+constexpr uint64_t Unreachable = std::numeric_limits<uint64_t>::max();
+
+// Random sparse directed graph with given average out degree
+Graph makeRandomGraph(uint32_t nodeCount, uint32_t avgDegree, uint32_t maxWeight)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> nodeDist(0, nodeCount - 1);
+    std::uniform_int_distribution<uint32_t> weightDist(1, maxWeight);
+
+    Graph graph(nodeCount);
+    for (uint32_t n = 0; n < nodeCount; n++)
+        for (uint32_t e = 0; e < avgDegree; e++)
+            graph[n].push_back({ nodeDist(gen), weightDist(gen) });
+
+    return graph;
+}
+
+// Dijkstra with lazy deletion using RadixHeap, keys are tentative distances
+Distances dijkstraRadixHeap(const Graph& graph, uint32_t source)
+{
+    Distances dist(graph.size(), Unreachable);
+    GADS::RadixHeap<uint64_t, uint32_t> queue;
+
+    dist[source] = 0;
+    queue.insert(0, source);
+
+    while (!queue.empty())
+    {
+        auto entry = queue.extractTop();
+        if (entry.first != dist[entry.second])
+            continue; // Stale entry
+
+        for (const auto& edge : graph[entry.second])
+        {
+            uint64_t newDist = entry.first + edge.weight;
+            if (newDist < dist[edge.target])
+            {
+                dist[edge.target] = newDist;
+                queue.insert(newDist, edge.target);
+            }
+        }
+    }
+
+    return dist;
+}
+
+// Dijkstra with lazy deletion using comparison based MinHeap
+Distances dijkstraMinHeap(const Graph& graph, uint32_t source)
+{
+    Distances dist(graph.size(), Unreachable);
+    GADS::MinHeap< std::pair<uint64_t, uint32_t> > queue;
+
+    dist[source] = 0;
+    queue.insert(0, source);
+
+    while (queue.size() > 0)
+    {
+        auto entry = queue.extractTop();
+        if (entry.first != dist[entry.second])
+            continue; // Stale entry
+
+        for (const auto& edge : graph[entry.second])
+        {
+            uint64_t newDist = entry.first + edge.weight;
+            if (newDist < dist[edge.target])
+            {
+                dist[edge.target] = newDist;
+                queue.insert(newDist, edge.target);
+            }
+        }
+    }
+
+    return dist;
+}
+
+void benchDijkstra(uint32_t nodeCount, uint32_t avgDegree, uint32_t maxWeight)
+{
+    const Graph graph = makeRandomGraph(nodeCount, avgDegree, maxWeight);
+    const std::string name = "Dijkstra n=" + std::to_string(nodeCount) + " deg=" + std::to_string(avgDegree)
+        + " maxW=" + std::to_string(maxWeight);
+
+    Distances radixDist;
+    Distances heapDist;
+
+    reportResult(name, "RadixHeap", measureMs([&]() { radixDist = dijkstraRadixHeap(graph, 0); }));
+    reportResult(name, "MinHeap", measureMs([&]() { heapDist = dijkstraMinHeap(graph, 0); }));
+
+    assert(radixDist == heapDist);
+    (void)radixDist; // Supress compiler warning in release builds
+}
+
+constexpr GADS::IndexType SelectedCount = 100;
+
+// Hand rolled selection with size check, extractTop and insert
+GADS::GenericVector<uint32_t> selectMinHeap(const GADS::GenericVector<uint32_t>& stream)
+{
+    GADS::MinHeap<uint32_t> heap;
+    for (auto val : stream)
+    {
+        if (heap.size() < SelectedCount)
+            heap.insert(val);
+        else if (heap.top() < val)
+        {
+            heap.extractTop();
+            heap.insert(val);
+        }
+    }
+
+    GADS::GenericVector<uint32_t> result;
+    while (heap.size() > 0)
+        result.push_back(heap.extractTop());
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+void benchTopK(GADS::IndexType streamSize)
+{
+    std::mt19937 gen(42);
+    GADS::GenericVector<uint32_t> stream(streamSize);
+    for (auto& val : stream)
+        val = gen();
+
+    const std::string name = "TopK k=" + std::to_string(SelectedCount) + " n=" + std::to_string(streamSize);
+
+    GADS::GenericVector<uint32_t> heapResult;
+    GADS::GenericVector<uint32_t> pushResult;
+    GADS::GenericVector<uint32_t> rangeResult;
+
+    reportResult(name, "MinHeap extractTop+insert", measureMs([&]() { heapResult = selectMinHeap(stream); }));
+
+    reportResult(name, "TopK push", measureMs([&]()
+        {
+            GADS::TopK<uint32_t, SelectedCount> topK;
+            for (auto val : stream)
+                topK.push(val);
+            pushResult = topK.extractSorted();
+        }));
+
+    reportResult(name, "TopK block filtered push", measureMs([&]()
+        {
+            GADS::TopK<uint32_t, SelectedCount> topK;
+            topK.push(stream.cbegin(), stream.cend());
+            rangeResult = topK.extractSorted();
+        }));
+
+    assert(heapResult == pushResult && heapResult == rangeResult);
+}
+
+// Median of every window recomputed with findNthSmallestElem
+GADS::GenericVector<int> recomputeMedians(const GADS::GenericVector<int>& data, GADS::IndexType windowSize)
+{
+    GADS::GenericVector<int> result;
+    GADS::GenericVector<int> window(windowSize);
+    for (GADS::IndexType beg = 0; beg + windowSize <= data.size(); beg++)
+    {
+        std::copy_n(data.cbegin() + beg, windowSize, window.begin());
+        result.push_back(GADS::findNthSmallestElem<int>(window.begin(), window.end(), (windowSize - 1) / 2 + 1));
+    }
+    return result;
+}
+
+void benchSlidingMedian(GADS::IndexType dataSize, GADS::IndexType windowSize, bool trending)
+{
+    std::mt19937 gen(42);
+    GADS::GenericVector<int> data(dataSize);
+    for (GADS::IndexType i = 0; i < dataSize; i++)
+        data[i] = static_cast<int>(gen() % 100000) + (trending ? static_cast<int>(i) : 0);
+
+    const std::string name = std::string("Sliding median ") + (trending ? "trending" : "random")
+        + " n=" + std::to_string(dataSize) + " w=" + std::to_string(windowSize);
+
+    GADS::GenericVector<int> recomputed;
+    GADS::GenericVector<int> tracked;
+    GADS::GenericVector<int> batched;
+
+    reportResult(name, "findNthSmallestElem per window", measureMs([&]() { recomputed = recomputeMedians(data, windowSize); }));
+
+    reportResult(name, "SlidingWindowMedian", measureMs([&]()
+        {
+            GADS::SlidingWindowMedian<int> median;
+            for (auto val : data)
+            {
+                median.push(val);
+                if (median.size() > windowSize)
+                    median.evictOldest();
+                if (median.size() == windowSize)
+                    tracked.push_back(median.median());
+            }
+        }));
+
+    reportResult(name, "slidingWindowQuantiles step 1", measureMs([&]() { batched = GADS::slidingWindowQuantiles(data, windowSize, 1, 0.5); }));
+
+    assert(recomputed == tracked && recomputed == batched);
+}
+
+// Record of given total size ordered by its key
+template <GADS::IndexType Size> struct Record
+{
+    Record(uint64_t k) : key(k) { payload[0] = static_cast<char>(k); }
+
+    uint64_t key;
+    char payload[Size - sizeof(uint64_t)];
+};
+
+struct RecordKey
+{
+    template <typename R> uint64_t operator()(const R& r) const { return r.key; }
+};
+
+// Inserts all keys and extracts all records, returns checksum of extracted keys order
+template <typename HeapType> uint64_t fillAndDrain(const GADS::GenericVector<uint64_t>& keys)
+{
+    HeapType heap;
+    for (auto key : keys)
+        heap.insert(key);
+
+    uint64_t checksum = 0;
+    while (heap.size() > 0)
+        checksum = checksum * 31 + heap.extractTop().key;
+    return checksum;
+}
+
+template <GADS::IndexType Size> void benchSplitHeap(GADS::IndexType count)
+{
+    std::mt19937_64 gen(42);
+    GADS::GenericVector<uint64_t> keys(count);
+    for (auto& key : keys)
+        key = gen();
+
+    using RecordType = Record<Size>;
+    const std::string name = "Heap of " + std::to_string(Size) + " byte records n=" + std::to_string(count);
+
+    uint64_t plain = 0;
+    uint64_t split = 0;
+
+    reportResult(name, "Heap", measureMs([&]() { plain = fillAndDrain< GADS::Heap< RecordType, GADS::KeyComparer<RecordType, RecordKey, std::less<uint64_t> > > >(keys); }));
+    reportResult(name, "SplitHeap", measureMs([&]() { split = fillAndDrain< GADS::SplitHeap<RecordType, RecordKey> >(keys); }));
+
+    assert(plain == split);
+    (void)plain; // Supress compiler warning in release builds
+}
+
+void benchExternalHeap(GADS::IndexType count, GADS::IndexType memoryBudget, GADS::IndexType blockBytes)
+{
+    std::mt19937_64 gen(42);
+    GADS::GenericVector<uint64_t> keys(count);
+    for (auto& key : keys)
+        key = gen();
+
+    const std::string name = "ExternalHeap n=" + std::to_string(count) + " budget=" + std::to_string(memoryBudget)
+        + " block=" + std::to_string(blockBytes);
+
+    uint64_t inMemory = 0;
+    uint64_t external = 0;
+    GADS::ExternalHeapStats stats;
+
+    reportResult(name, "MinHeap", measureMs([&]()
+        {
+            GADS::MinHeap<uint64_t> heap;
+            for (auto key : keys)
+                heap.insert(key);
+            while (heap.size() > 0)
+                inMemory = inMemory * 31 + heap.extractTop();
+        }));
+    reportResult(name, "ExternalHeap", measureMs([&]()
+        {
+            GADS::ExternalHeap<uint64_t> heap(memoryBudget, blockBytes);
+            for (auto key : keys)
+                heap.insert(key);
+            while (heap.size() > 0)
+                external = external * 31 + heap.extractTop();
+            stats = heap.ioStats();
+        }));
+
+    std::cout << name << " | I/O | written " << stats.bytesWritten << " B in " << stats.blocksWritten << " blocks, read "
+        << stats.bytesRead << " B in " << stats.blocksRead << " blocks, " << stats.runsWritten << " runs, "
+        << stats.runMerges << " merges" << std::endl;
+
+    assert(inMemory == external);
+}
+
+}
+
+int main()
+{
+    benchDijkstra(100000, 8, 100);
+    benchDijkstra(100000, 8, 1000000);
+    benchDijkstra(1000000, 4, 1000);
+
+    benchTopK(10000000);
+
+    benchSlidingMedian(50000, 1001, false);
+    benchSlidingMedian(50000, 1001, true);
+
+    benchSplitHeap<16>(500000);
+    benchSplitHeap<64>(500000);
+    benchSplitHeap<200>(500000);
+    benchSplitHeap<512>(500000);
+
+    benchExternalHeap(2000000, 4 << 20, 64 << 10);
+    benchExternalHeap(2000000, 1 << 20, 64 << 10);
+}
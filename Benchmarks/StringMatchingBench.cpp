@@ -0,0 +1,480 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "FuzzyDictionary.h"
+#include "StringDistance.h"
+#include "ThreadPool.h"
+#include "BenchmarkUtils.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+namespace
+{
+
+// Random text over first alphabetSize lowercase letters
+std::string makeRandomText(GADS::IndexType len, unsigned alphabetSize, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::string text(len, 'a');
+    for (auto& c : text)
+        c = static_cast<char>('a' + gen() % alphabetSize);
+    return text;
+}
+
+// Prints dynamic programming cells computed per second
+void reportCells(const std::string& benchmark, const std::string& variant, double cells, double ms)
+{
+    std::cout << benchmark << " | " << variant << " | " << ms << " ms, " << cells / (ms * 1e6) << " Gcells/s" << std::endl;
+}
+
+// Former length computation of longestCommonSubsequence(): the full (n + 1) x (m + 1) table
+GADS::IndexType lcsTableLength(const std::string& s1, const std::string& s2)
+{
+    GADS::GenericVector<GADS::IndexVct> t(s1.size() + 1, GADS::IndexVct(s2.size() + 1, 0));
+    for (GADS::IndexType i = 1; i <= s1.size(); i++)
+    {
+        for (GADS::IndexType j = 1; j <= s2.size(); j++)
+            t[i][j] = (s1[i - 1] == s2[j - 1]) ? t[i - 1][j - 1] + 1 : std::max(t[i][j - 1], t[i - 1][j]);
+    }
+    return t.back().back();
+}
+
+// Longest common subsequence length: full table against the bit-parallel kernels
+// The table of (n + 1)^2 indexes is only filled up to maxTableLen
+void benchLcsLength(GADS::IndexType len, GADS::IndexType maxTableLen)
+{
+    const std::string fullName = "LCS length n=m=" + std::to_string(len);
+    const std::string s1 = makeRandomText(len, 4, 1);
+    const std::string s2 = makeRandomText(len, 4, 2);
+    const double cells = static_cast<double>(len) * len;
+
+    GADS::IndexType expected = 0;
+    if (len <= maxTableLen)
+    {
+        reportCells(fullName, "table (former)", cells, measureMs([&]()
+            {
+                expected = lcsTableLength(s1, s2);
+            }));
+    }
+
+    GADS::IndexType length = 0;
+    reportCells(fullName, "bit-parallel scalar", cells, measureMs([&]()
+        {
+            length = GADS::longestCommonSubsequenceLength(s1, s2, GADS::SimdLevel::None);
+        }));
+    assert(expected == 0 || length == expected);
+
+    if (GADS::supportedSimdLevel() >= GADS::SimdLevel::AVX2)
+    {
+        GADS::IndexType vectorLength = 0;
+        reportCells(fullName, "bit-parallel AVX2", cells, measureMs([&]()
+            {
+                vectorLength = GADS::longestCommonSubsequenceLength(s1, s2, GADS::SimdLevel::AVX2);
+            }));
+        assert(vectorLength == length);
+    }
+    std::cout << fullName << " | length | " << length << std::endl;
+}
+
+// One longest common subsequence: full table with a single traceback against Hirschberg's linear space recursion
+void benchLcsWitness(GADS::IndexType len, GADS::IndexType maxTableLen)
+{
+    const std::string fullName = "LCS witness n=m=" + std::to_string(len);
+    const std::string s1 = makeRandomText(len, 4, 3);
+    const std::string s2 = makeRandomText(len, 4, 4);
+
+    if (len <= maxTableLen)
+    {
+        std::string tableWitness;
+        reportResult(fullName, "table traceback", measureMs([&]()
+            {
+                GADS::GenericVector<GADS::IndexVct> t(len + 1, GADS::IndexVct(len + 1, 0));
+                for (GADS::IndexType i = 1; i <= len; i++)
+                {
+                    for (GADS::IndexType j = 1; j <= len; j++)
+                        t[i][j] = (s1[i - 1] == s2[j - 1]) ? t[i - 1][j - 1] + 1 : std::max(t[i][j - 1], t[i - 1][j]);
+                }
+                for (GADS::IndexType i = len, j = len; i > 0 && j > 0;)
+                {
+                    if (s1[i - 1] == s2[j - 1])
+                    {
+                        tableWitness += s1[--i];
+                        j--;
+                    }
+                    else if (t[i - 1][j] >= t[i][j - 1])
+                        i--;
+                    else
+                        j--;
+                }
+            }));
+        std::cout << fullName << " | table memory | " << (len + 1) * (len + 1) * sizeof(GADS::IndexType) << " B, length " << tableWitness.size() << std::endl;
+    }
+
+    std::string witness;
+    reportResult(fullName, "Hirschberg scalar", measureMs([&]()
+        {
+            GADS::longestCommonSubsequenceWitness(s1, s2, witness, GADS::SimdLevel::None);
+        }));
+    if (GADS::supportedSimdLevel() >= GADS::SimdLevel::AVX2)
+    {
+        reportResult(fullName, "Hirschberg AVX2", measureMs([&]()
+            {
+                GADS::longestCommonSubsequenceWitness(s1, s2, witness, GADS::SimdLevel::AVX2);
+            }));
+    }
+    std::cout << fullName << " | length | " << witness.size() << std::endl;
+}
+
+// Capped enumeration on strings with 2^blockCount distinct longest common subsequences
+void benchLcsEnumeration(GADS::IndexType blockCount, GADS::IndexType maxCount)
+{
+    const std::string fullName = "LCS enumeration blocks=" + std::to_string(blockCount) + " cap=" + std::to_string(maxCount);
+
+    std::string s1;
+    std::string s2;
+    for (GADS::IndexType i = 0; i < blockCount; i++)
+    {
+        s1 += "abc";
+        s2 += "bac";
+    }
+
+    GADS::IndexType found = 0;
+    reportResult(fullName, "longestCommonSubsequences", measureMs([&]()
+        {
+            found = GADS::longestCommonSubsequences(s1, s2, maxCount).size();
+        }));
+    std::cout << fullName << " | subsequences | " << found << std::endl;
+}
+
+// Former approximativeStringMatching(): table of rows initialized like the default MatchConfig::createTable(),
+// a vector of operation costs per cell
+GADS::IndexType formerApproximativeStringMatching(const std::string& s1, const std::string& s2, const GADS::MatchConfig& matchConfig)
+{
+    GADS::GenericVector< GADS::GenericVector<GADS::IndexType> > t(s1.size() + 1);
+    for (GADS::IndexType i = 0; i <= s1.size(); i++)
+    {
+        t[i].assign(s2.size() + 1, std::numeric_limits<GADS::IndexType>::max());
+        t[i].front() = i;
+    }
+    std::iota(t[0].begin(), t[0].end(), 0);
+
+    for (GADS::IndexType i = 1; i <= s1.size(); i++)
+    {
+        for (GADS::IndexType j = 1; j <= s2.size(); j++)
+        {
+            GADS::GenericVector<GADS::IndexType> operCost;
+            operCost.reserve(3); // match, insert, delete
+            operCost.push_back(t[i - 1][j - 1] + matchConfig.matchCost(s1[i - 1], s2[j - 1]));
+            operCost.push_back(t[i][j - 1] + matchConfig.insertCost(s1[i - 1]));
+            operCost.push_back(t[i - 1][j] + matchConfig.deleteCost(s1[i - 1]));
+            for (GADS::IndexType k = 0; k < operCost.size(); k++)
+            {
+                if (operCost[k] < t[i][j])
+                    t[i][j] = operCost[k];
+            }
+        }
+    }
+    return t.back().back();
+}
+
+// Edit distance: former table kernel against the virtual adapter and the inlined unit cost policy
+// The former table of (n + 1)^2 indexes is only filled up to maxTableLen
+void benchEditDistance(GADS::IndexType len, GADS::IndexType maxTableLen)
+{
+    const std::string fullName = "Edit distance n=m=" + std::to_string(len);
+    const std::string s1 = makeRandomText(len, 4, 5);
+    const std::string s2 = makeRandomText(len, 4, 6);
+    const double cells = static_cast<double>(len) * len;
+    const GADS::MatchConfigGenericImpl matchConfig;
+
+    GADS::IndexType expected = 0;
+    if (len <= maxTableLen)
+    {
+        reportCells(fullName, "table (former)", cells, measureMs([&]()
+            {
+                expected = formerApproximativeStringMatching(s1, s2, matchConfig);
+            }));
+    }
+
+    GADS::IndexType distance = 0;
+    reportCells(fullName, "MatchConfig adapter", cells, measureMs([&]()
+        {
+            distance = GADS::approximativeStringMatching(std::string_view(s1), std::string_view(s2), GADS::MatchConfigCostPolicy(matchConfig));
+        }));
+    assert(expected == 0 || distance == expected);
+
+    int32_t unitDistance = 0;
+    reportCells(fullName, "UnitCostPolicy", cells, measureMs([&]()
+        {
+            unitDistance = GADS::approximativeStringMatching(std::string_view(s1), std::string_view(s2), GADS::UnitCostPolicy());
+        }));
+    assert(static_cast<GADS::IndexType>(unitDistance) == distance);
+
+    GADS::IndexType bitDistance = 0;
+    reportCells(fullName, "bit-parallel editDistance", cells, measureMs([&]()
+        {
+            bitDistance = GADS::editDistance(s1, s2);
+        }));
+    assert(bitDistance == distance);
+
+    GADS::GenericSet<std::string> sequences;
+    if (len <= maxTableLen)
+    {
+        reportCells(fullName, "UnitCostPolicy traceback", cells, measureMs([&]()
+            {
+                GADS::approximativeStringMatching(std::string_view(s1), std::string_view(s2), GADS::UnitCostPolicy(), &sequences);
+            }));
+    }
+    std::cout << fullName << " | distance | " << distance << std::endl;
+}
+
+// Copy of text with edits random substitutions, insertions and deletions
+std::string mutateText(const std::string& text, GADS::IndexType edits, unsigned alphabetSize, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::string result = text;
+    for (GADS::IndexType e = 0; e < edits; e++)
+    {
+        const char c = static_cast<char>('a' + gen() % alphabetSize);
+        const GADS::IndexType pos = gen() % result.size();
+        switch (gen() % 3)
+        {
+        case 0:
+            result[pos] = c;
+            break;
+        case 1:
+            result.insert(result.begin() + pos, c);
+            break;
+        default:
+            result.erase(result.begin() + pos);
+        }
+    }
+    return result;
+}
+
+// Bounded edit distance by k: a pair at distance about edits and an unrelated pair, against the full bit-parallel scan
+void benchEditDistanceWithin(GADS::IndexType len, GADS::IndexType edits)
+{
+    const std::string fullName = "Edit distance within k n=" + std::to_string(len) + " edits=" + std::to_string(edits);
+    const std::string text = makeRandomText(len, 4, 7);
+    const std::string similar = mutateText(text, edits, 4, 8);
+    const std::string unrelated = makeRandomText(len, 4, 9);
+    const double cells = static_cast<double>(len) * len;
+
+    GADS::IndexType distance = 0;
+    reportCells(fullName, "editDistance similar", cells, measureMs([&]()
+        {
+            distance = GADS::editDistance(text, similar);
+        }));
+    std::cout << fullName << " | distance | " << distance << std::endl;
+
+    for (GADS::IndexType k : { 10, 100, 1000, 10000 })
+    {
+        GADS::IndexType bounded = 0;
+        const double ms = measureMs([&]()
+            {
+                bounded = GADS::editDistanceWithin(text, similar, k);
+            });
+        assert(bounded == std::min(distance, k + 1));
+        reportCells(fullName, "similar k=" + std::to_string(k), cells, ms);
+
+        const double unrelatedMs = measureMs([&]()
+            {
+                bounded = GADS::editDistanceWithin(text, unrelated, k);
+            });
+        assert(bounded == k + 1);
+        reportCells(fullName, "unrelated k=" + std::to_string(k), cells, unrelatedMs);
+    }
+}
+
+// Substitutions of neighbouring letters cost 1, others 3, deletions 1 and insertions 2
+GADS::EditCostTable makeKeyboardCosts()
+{
+    const std::string rows[] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+    GADS::EditCostTable costs;
+    for (char c1 = 'a'; c1 <= 'z'; c1++)
+    {
+        costs.setInsertCost(c1, 2);
+        for (char c2 = 'a'; c2 <= 'z'; c2++)
+            costs.setMatchCost(c1, c2, (c1 == c2) ? 0 : 3);
+    }
+    for (const auto& row : rows)
+    {
+        for (GADS::IndexType i = 0; i + 1 < row.size(); i++)
+        {
+            costs.setMatchCost(row[i], row[i + 1], 1);
+            costs.setMatchCost(row[i + 1], row[i], 1);
+        }
+    }
+    return costs;
+}
+
+// Weighted edit distance: scalar policy kernel against the striped SSE2 and AVX2 kernels
+// A similar pair stays in narrow lanes, an unrelated pair is promoted to wider ones
+void benchWeightedEditDistance(GADS::IndexType len, GADS::IndexType edits)
+{
+    const std::string fullName = "Weighted edit distance n=m=" + std::to_string(len) + " edits=" + std::to_string(edits);
+    const std::string s1 = makeRandomText(len, 26, 10);
+    const std::string s2 = (edits < len) ? mutateText(s1, edits, 26, 11) : makeRandomText(len, 26, 11);
+    const double cells = static_cast<double>(s1.size()) * s2.size();
+    const GADS::EditCostTable costs = makeKeyboardCosts();
+
+    GADS::IndexType expected = 0;
+    reportCells(fullName, "scalar", cells, measureMs([&]()
+        {
+            expected = GADS::weightedEditDistance(s1, s2, costs, GADS::SimdLevel::None);
+        }));
+
+    const std::pair<GADS::SimdLevel, const char*> levels[] = { { GADS::SimdLevel::SSE2, "striped SSE2" }, { GADS::SimdLevel::AVX2, "striped AVX2" } };
+    for (const auto& level : levels)
+    {
+        if (GADS::supportedSimdLevel() < level.first)
+            continue;
+        GADS::IndexType distance = 0;
+        reportCells(fullName, level.second, cells, measureMs([&]()
+            {
+                distance = GADS::weightedEditDistance(s1, s2, costs, level.first);
+            }));
+        assert(distance == expected);
+    }
+    std::cout << fullName << " | distance | " << expected << std::endl;
+}
+
+// Prints elapsed time and number of queries per second
+void reportThroughput(const std::string& benchmark, const std::string& variant, GADS::IndexType queryCount, double ms)
+{
+    reportResult(benchmark, variant, ms);
+    std::cout << benchmark << " | " << variant << " | " << static_cast<GADS::IndexType>(queryCount / (ms / 1000.0)) << " queries/s" << std::endl;
+}
+
+// Fuzzy search of misspelled words in a dictionary of 2 to 4 syllables out of 500 random ones, words share parts
+// like in a natural language: a distance to every word against the trie, single threaded and on a thread pool
+void benchFuzzyDictionary(GADS::IndexType wordCount, GADS::IndexType queryCount)
+{
+    const std::string fullName = "Fuzzy dictionary words=" + std::to_string(wordCount);
+    std::mt19937 gen(12);
+    GADS::GenericVector<std::string> syllables(500);
+    for (auto& syllable : syllables)
+        syllable = makeRandomText(2 + gen() % 2, 26, gen());
+
+    GADS::GenericVector<std::string> words(wordCount);
+    for (auto& word : words)
+    {
+        for (GADS::IndexType s = 2 + gen() % 3; s > 0; s--)
+            word += syllables[gen() % syllables.size()];
+    }
+
+    GADS::GenericVector<std::string> storage(queryCount);
+    for (auto& query : storage)
+        query = mutateText(words[gen() % wordCount], 1 + gen() % 2, 26, gen());
+    const GADS::GenericVector<std::string_view> queries(storage.begin(), storage.end());
+
+    std::unique_ptr<GADS::FuzzyDictionary> dictionary;
+    reportResult(fullName, "build", measureMs([&]()
+        {
+            dictionary = std::make_unique<GADS::FuzzyDictionary>(words);
+        }));
+    std::cout << fullName << " | trie nodes | " << dictionary->nodeCount() << std::endl;
+
+    // Scans of the whole dictionary only for the first queries
+    const GADS::IndexType scanCount = std::min<GADS::IndexType>(queryCount, 20);
+    const GADS::IndexType k = 2;
+    GADS::IndexType scanMatches = 0;
+    reportThroughput(fullName, "approximativeStringMatching per word k=2", scanCount, measureMs([&]()
+        {
+            for (GADS::IndexType q = 0; q < scanCount; q++)
+            {
+                for (const auto& word : words)
+                    scanMatches += GADS::approximativeStringMatching(queries[q], std::string_view(word), GADS::UnitCostPolicy()) <= static_cast<int32_t>(k);
+            }
+        }));
+
+    GADS::IndexType boundedMatches = 0;
+    reportThroughput(fullName, "editDistanceWithin per word k=2", scanCount, measureMs([&]()
+        {
+            for (GADS::IndexType q = 0; q < scanCount; q++)
+            {
+                for (const auto& word : words)
+                    boundedMatches += GADS::editDistanceWithin(queries[q], word, k) <= k;
+            }
+        }));
+    assert(boundedMatches == scanMatches);
+
+    GADS::ThreadPool pool;
+    const std::string threads = std::to_string(pool.size()) + " threads";
+    for (GADS::IndexType bound : { 1, 2 })
+    {
+        const std::string variant = "trie k=" + std::to_string(bound);
+        GADS::IndexType visited = 0;
+        GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > single;
+        reportThroughput(fullName, variant, queryCount, measureMs([&]()
+            {
+                single = dictionary->findWithin(queries, bound, nullptr, &visited);
+            }));
+        std::cout << fullName << " | " << variant << " | " << visited / queryCount << " nodes/query" << std::endl;
+
+        GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > parallel;
+        reportThroughput(fullName, variant + " " + threads, queryCount, measureMs([&]()
+            {
+                parallel = dictionary->findWithin(queries, bound, &pool);
+            }));
+        assert(parallel == single);
+
+        if (bound == k)
+        {
+            GADS::IndexType found = 0;
+            for (GADS::IndexType q = 0; q < scanCount; q++)
+                found += single[q].size();
+            assert(found == scanMatches);
+        }
+    }
+
+    GADS::IndexType visited = 0;
+    GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > nearest;
+    reportThroughput(fullName, "trie nearest 10", queryCount, measureMs([&]()
+        {
+            nearest = dictionary->findNearest(queries, 10, nullptr, &visited);
+        }));
+    std::cout << fullName << " | trie nearest 10 | " << visited / queryCount << " nodes/query" << std::endl;
+
+    GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > parallel;
+    reportThroughput(fullName, "trie nearest 10 " + threads, queryCount, measureMs([&]()
+        {
+            parallel = dictionary->findNearest(queries, 10, &pool);
+        }));
+    assert(parallel == nearest);
+}
+
+} // End of anonymous namespace
+
+int main()
+{
+    for (GADS::IndexType len : { 100, 1000, 10000, 100000, 1000000 })
+        benchLcsLength(len, 4000);
+
+    for (GADS::IndexType len : { 1000, 4000, 100000 })
+        benchLcsWitness(len, 4000);
+
+    benchLcsEnumeration(40, 1000);
+    benchLcsEnumeration(1000, 100000);
+
+    for (GADS::IndexType len : { 100, 1000, 4000, 20000 })
+        benchEditDistance(len, 4000);
+
+    for (GADS::IndexType edits : { 100, 3000 })
+        benchEditDistanceWithin(100000, edits);
+
+    for (GADS::IndexType len : { 1000, 20000 })
+    {
+        for (GADS::IndexType edits : { len / 100, len / 10, len })
+            benchWeightedEditDistance(len, edits);
+    }
+
+    for (GADS::IndexType wordCount : { 100000, 1000000 })
+        benchFuzzyDictionary(wordCount, 1000);
+}
@@ -0,0 +1,648 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "FMIndex.h"
+#include "GeneralizedSuffixArray.h"
+#include "SegmentedSuffixArray.h"
+#include "StringRotation.h"
+#include "SuffixArray.h"
+#include "ThreadPool.h"
+#include "BenchmarkUtils.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+namespace
+{
+
+// Random text over first alphabetSize lowercase letters
+std::string makeRandomText(GADS::IndexType len, unsigned alphabetSize)
+{
+    std::mt19937 gen(42);
+    std::string text(len, 'a');
+    for (auto& c : text)
+        c = static_cast<char>('a' + gen() % alphabetSize);
+    return text;
+}
+
+// Highly repetitive text: short period with rare mutations
+std::string makeRepetitiveText(GADS::IndexType len)
+{
+    std::mt19937 gen(42);
+    const std::string period = "abcabdabcabe";
+    std::string text(len, 'a');
+    for (GADS::IndexType i = 0; i < len; i++)
+        text[i] = (gen() % 1000 == 0) ? 'z' : period[i % period.size()];
+    return text;
+}
+
+// Natural language like text: words drawn from a Zipf distributed vocabulary
+std::string makeNaturalText(GADS::IndexType len)
+{
+    const char* words[] = { "the", "of", "and", "to", "in", "a", "is", "that", "for", "it", "as", "was", "with",
+        "be", "by", "on", "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an",
+        "had", "they", "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if",
+        "more", "when", "will", "would", "who", "so", "no", "index", "suffix", "array", "search", "query" };
+    const GADS::IndexType wordCount = sizeof(words) / sizeof(words[0]);
+
+    GADS::GenericVector<double> weights(wordCount);
+    for (GADS::IndexType i = 0; i < wordCount; i++)
+        weights[i] = 1.0 / (i + 1);
+
+    std::mt19937 gen(42);
+    std::discrete_distribution<GADS::IndexType> wordDist(weights.begin(), weights.end());
+
+    std::string text;
+    text.reserve(len + 16);
+    while (text.size() < len)
+    {
+        text += words[wordDist(gen)];
+        text += ' ';
+    }
+    text.resize(len);
+    return text;
+}
+
+void benchConstruction(const std::string& name, const std::string& text, bool withPrefixDoubling)
+{
+    const std::string fullName = "SA construction " + name + " n=" + std::to_string(text.size());
+
+    GADS::IndexVct inducing;
+    reportResult(fullName, "InducedSorting", measureMs([&]()
+        {
+            inducing = GADS::SuffixArray(text, GADS::SuffixArrayConstruction::InducedSorting).get();
+        }));
+
+    if (withPrefixDoubling)
+    {
+        GADS::IndexVct doubling;
+        reportResult(fullName, "PrefixDoubling", measureMs([&]()
+            {
+                doubling = GADS::SuffixArray(text, GADS::SuffixArrayConstruction::PrefixDoubling).get();
+            }));
+        assert(inducing == doubling);
+    }
+}
+
+// Parallel prefix doubling against induced sorting for growing numbers of threads
+void benchParallelConstruction(const std::string& name, const std::string& text)
+{
+    const std::string fullName = "SA parallel construction " + name + " n=" + std::to_string(text.size());
+
+    const GADS::SuffixArrayOptions inducing(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::None);
+    GADS::IndexVct expected;
+    reportResult(fullName, "InducedSorting", measureMs([&]() { expected = GADS::SuffixArray(text, inducing).get(); }));
+
+    const GADS::IndexType hardwareThreads = GADS::ThreadPool().size();
+    for (GADS::IndexType threads = 1; threads <= std::max<GADS::IndexType>(16, hardwareThreads); threads *= 2)
+    {
+        const GADS::SuffixArrayOptions options(GADS::SuffixArrayConstruction::ParallelPrefixDoubling, GADS::LcpSupport::None,
+            GADS::IndexWidth::Auto, threads);
+        GADS::IndexVct result;
+        reportResult(fullName, "ParallelPrefixDoubling threads=" + std::to_string(threads), measureMs([&]()
+            {
+                result = GADS::SuffixArray(text, options).get();
+            }));
+        assert(result == expected);
+    }
+}
+
+// Byte text against the same text tokenised into 32-bit word ids, searched for two-word phrases
+void benchTokens(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA tokens " + name + " n=" + std::to_string(text.size());
+
+    using TokenSuffixArray = GADS::BasicSuffixArray<uint32_t>;
+    TokenSuffixArray::Text tokens;
+    GADS::IndexVct tokenStarts;
+    std::unordered_map<std::string, uint32_t> vocabulary;
+    for (GADS::IndexType pos = 0; pos < text.size();)
+    {
+        const GADS::IndexType end = std::min(text.find(' ', pos), text.size());
+        const auto id = vocabulary.emplace(text.substr(pos, end - pos), static_cast<uint32_t>(vocabulary.size())).first->second;
+        tokens.push_back(id);
+        tokenStarts.push_back(pos);
+        pos = end + 1;
+    }
+    std::cout << fullName << " | tokens | " << tokens.size() << ", vocabulary " << vocabulary.size() << std::endl;
+
+    std::unique_ptr<GADS::SuffixArray> bytes;
+    reportResult(fullName, "build bytes", measureMs([&]() { bytes = std::make_unique<GADS::SuffixArray>(text); }));
+    std::unique_ptr<TokenSuffixArray> words;
+    reportResult(fullName, "build tokens", measureMs([&]() { words = std::make_unique<TokenSuffixArray>(tokens); }));
+    reportResult(fullName, "build tokens with alphabet size", measureMs([&]()
+        {
+            words = std::make_unique<TokenSuffixArray>(tokens, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting,
+                GADS::LcpSupport::BlockSparseTable, GADS::IndexWidth::Auto, 0, vocabulary.size()));
+        }));
+    std::cout << fullName << " | memory bytes | " << bytes->memoryUsage() << " B" << std::endl;
+    std::cout << fullName << " | memory tokens | " << words->memoryUsage() << " B" << std::endl;
+
+    // Phrases of two whole words, as text and as token ids
+    std::mt19937 gen(37);
+    GADS::GenericVector<std::string_view> phrases(queryCount);
+    GADS::GenericVector<TokenSuffixArray::TextView> tokenPhrases(queryCount);
+    for (GADS::IndexType q = 0; q < queryCount; q++)
+    {
+        const GADS::IndexType t = gen() % (tokens.size() - 3);
+        phrases[q] = std::string_view(text).substr(tokenStarts[t], tokenStarts[t + 2] - tokenStarts[t]);
+        tokenPhrases[q] = TokenSuffixArray::TextView(tokens).substr(t, 2);
+    }
+
+    GADS::IndexType checksum = 0;
+    reportResult(fullName, "count bytes", measureMs([&]()
+        {
+            for (const auto& phrase : phrases)
+                checksum += bytes->count(phrase);
+        }));
+    reportResult(fullName, "count tokens", measureMs([&]()
+        {
+            for (const auto& phrase : tokenPhrases)
+                checksum += words->count(phrase);
+        }));
+    (void)checksum;
+}
+
+void benchLcpQueries(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA lcp " + name + " n=" + std::to_string(text.size()) + " queries=" + std::to_string(queryCount);
+
+    // Size of the prefix order matrix used by lcp() before LCP array support: 1 + ceil(log2 n) rows of n indexes
+    GADS::IndexType matrixRows = 1;
+    for (GADS::IndexType cnt = 1; cnt < text.size(); cnt <<= 1)
+        matrixRows++;
+    std::cout << fullName << " | prefix order matrix (former) | " << matrixRows * text.size() * sizeof(GADS::IndexType) << " B" << std::endl;
+
+    std::mt19937 gen(7);
+    GADS::IndexVct positions(2 * queryCount);
+    for (auto& pos : positions)
+        pos = gen() % text.size();
+
+    const std::pair<GADS::LcpSupport, const char*> supports[] = { { GADS::LcpSupport::SparseTable, "SparseTable" },
+        { GADS::LcpSupport::BlockSparseTable, "BlockSparseTable" }, { GADS::LcpSupport::None, "None" } };
+
+    for (const auto& support : supports)
+    {
+        const GADS::SuffixArray sa(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support.first));
+        std::cout << fullName << " | " << support.second << " memory | " << sa.memoryUsage() << " B" << std::endl;
+
+        GADS::IndexType checksum = 0;
+        reportResult(fullName, std::string(support.second) + " queries", measureMs([&]()
+            {
+                for (GADS::IndexType q = 0; q < queryCount; q++)
+                    checksum += sa.lcp(positions[2 * q], positions[2 * q + 1]);
+            }));
+        (void)checksum;
+    }
+}
+
+void benchIndexWidth(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA index width " + name + " n=" + std::to_string(text.size());
+
+    std::mt19937 gen(11);
+    GADS::GenericVector<std::string> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = text.substr(gen() % (text.size() - 8), 8);
+
+    const std::pair<GADS::IndexWidth, const char*> widths[] = { { GADS::IndexWidth::Bits64, "64-bit" },
+        { GADS::IndexWidth::Bits40, "40-bit" }, { GADS::IndexWidth::Bits32, "32-bit" } };
+
+    for (const auto& width : widths)
+    {
+        const GADS::SuffixArrayOptions options(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::BlockSparseTable, width.first);
+
+        std::unique_ptr<GADS::SuffixArray> sa;
+        reportResult(fullName, std::string(width.second) + " construction", measureMs([&]()
+            {
+                sa = std::make_unique<GADS::SuffixArray>(text, options);
+            }));
+        std::cout << fullName << " | " << width.second << " memory | " << sa->memoryUsage() << " B" << std::endl;
+
+        GADS::IndexType checksum = 0;
+        reportResult(fullName, std::string(width.second) + " searches", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                    checksum += sa->searchSubstring(pattern);
+            }));
+        (void)checksum;
+    }
+}
+
+void benchPersistence(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA index file " + name + " n=" + std::to_string(text.size());
+    const std::string path = "SuffixArrayBench.idx";
+
+    std::unique_ptr<GADS::SuffixArray> built;
+    reportResult(fullName, "build", measureMs([&]()
+        {
+            built = std::make_unique<GADS::SuffixArray>(text);
+        }));
+    reportResult(fullName, "save", measureMs([&]() { built->save(path); }));
+
+    std::mt19937 gen(13);
+    GADS::GenericVector<std::string> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = text.substr(gen() % (text.size() - 8), 8);
+
+    for (bool verify : { false, true })
+    {
+        std::unique_ptr<GADS::SuffixArray> loaded;
+        reportResult(fullName, verify ? "load verified" : "load", measureMs([&]()
+            {
+                loaded = std::make_unique<GADS::SuffixArray>(GADS::SuffixArray::load(path, verify));
+            }));
+
+        GADS::IndexType checksum = 0;
+        reportResult(fullName, verify ? "searches after verified load" : "searches after load", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                    checksum += loaded->searchSubstring(pattern);
+            }));
+        (void)checksum;
+    }
+
+    std::remove(path.c_str());
+}
+
+// Patterns taken from a repetitive text match many suffixes sharing long prefixes
+void benchOccurrences(const std::string& name, const std::string& text, GADS::IndexType patternLen, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA occurrences " + name + " n=" + std::to_string(text.size()) + " m=" + std::to_string(patternLen);
+
+    std::mt19937 gen(17);
+    GADS::GenericVector<std::string> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = text.substr(gen() % (text.size() - patternLen), patternLen);
+
+    const std::pair<GADS::LcpSupport, const char*> supports[] = { { GADS::LcpSupport::BlockSparseTable, "lcp skipping" },
+        { GADS::LcpSupport::None, "border match skipping" } };
+
+    for (const auto& support : supports)
+    {
+        const GADS::SuffixArray sa(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support.first));
+
+        GADS::IndexType total = 0;
+        reportResult(fullName, std::string(support.second) + " count", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                    total += sa.count(pattern);
+            }));
+
+        GADS::IndexType checksum = 0;
+        reportResult(fullName, std::string(support.second) + " enumerate", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                {
+                    for (auto pos : sa.occurrences(pattern))
+                        checksum += pos;
+                }
+            }));
+        std::cout << fullName << " | occurrences | " << total << std::endl;
+        (void)checksum;
+    }
+}
+
+void reportThroughput(const std::string& benchmark, const std::string& variant, GADS::IndexType queryCount, double ms)
+{
+    reportResult(benchmark, variant, ms);
+    std::cout << benchmark << " | " << variant << " | " << static_cast<GADS::IndexType>(queryCount / (ms / 1000.0)) << " queries/s" << std::endl;
+}
+
+// Canonical rotations of many short circular identifiers, directly and through a suffix array build per identifier
+void benchRotations(GADS::IndexType idCount, GADS::IndexType idLen)
+{
+    const std::string fullName = "Minimal rotation ids=" + std::to_string(idCount) + " length=" + std::to_string(idLen);
+
+    const std::string text = makeRandomText(idCount * idLen, 4);
+    GADS::GenericVector<std::string_view> ids(idCount);
+    for (GADS::IndexType i = 0; i < idCount; i++)
+        ids[i] = std::string_view(text).substr(i * idLen, idLen);
+
+    GADS::IndexType startSum = 0;
+    reportThroughput(fullName, "minimalRotation", idCount, measureMs([&]()
+        {
+            for (const auto& id : ids)
+                startSum += GADS::minimalRotation(id);
+        }));
+    std::cout << fullName << " | mean rotation start | " << static_cast<double>(startSum) / idCount << std::endl;
+
+    GADS::IndexType checksum = 0;
+
+    const GADS::IndexType saCount = idCount / 10;
+    const GADS::SuffixArrayOptions options(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::None);
+    reportThroughput(fullName, "suffix array per id", saCount, measureMs([&]()
+        {
+            for (GADS::IndexType i = 0; i < saCount; i++)
+                checksum += GADS::SuffixArray::fromView(ids[i], options).get()[0];
+        }));
+    (void)checksum;
+}
+
+void benchBatchQueries(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "SA batch " + name + " n=" + std::to_string(text.size()) + " queries=" + std::to_string(queryCount);
+
+    std::mt19937 gen(19);
+    GADS::GenericVector<std::string> storage(queryCount);
+    for (auto& pattern : storage)
+        pattern = text.substr(gen() % (text.size() - 24), 4 + gen() % 20);
+    const GADS::GenericVector<std::string_view> patterns(storage.begin(), storage.end());
+
+    const GADS::SuffixArray sa(text);
+
+    GADS::GenericVector< std::pair<GADS::IndexType, GADS::IndexType> > single(queryCount);
+    reportThroughput(fullName, "single calls", queryCount, measureMs([&]()
+        {
+            for (GADS::IndexType i = 0; i < queryCount; i++)
+                single[i] = sa.findRange(patterns[i]);
+        }));
+
+    GADS::GenericVector< std::pair<GADS::IndexType, GADS::IndexType> > batch;
+    reportThroughput(fullName, "sorted batch", queryCount, measureMs([&]()
+        {
+            batch = sa.findRanges(patterns);
+        }));
+    assert(batch == single);
+
+    GADS::ThreadPool pool;
+    reportThroughput(fullName, "sorted batch " + std::to_string(pool.size()) + " threads", queryCount, measureMs([&]()
+        {
+            batch = sa.findRanges(patterns, &pool);
+        }));
+    assert(batch == single);
+}
+
+void benchFMIndex(const std::string& name, const std::string& text, GADS::IndexType queryCount)
+{
+    const std::string fullName = "FM-index " + name + " n=" + std::to_string(text.size());
+
+    std::mt19937 gen(23);
+    GADS::GenericVector<std::string> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = text.substr(gen() % (text.size() - 16), 4 + gen() % 12);
+
+    const GADS::SuffixArray sa(text);
+    std::cout << fullName << " | suffix array memory | " << sa.memoryUsage() << " B" << std::endl;
+
+    GADS::IndexType checksum = 0;
+    reportResult(fullName, "suffix array count", measureMs([&]()
+        {
+            for (const auto& pattern : patterns)
+                checksum += sa.count(pattern);
+        }));
+
+    for (GADS::IndexType sampleRate : { 32, 128 })
+    {
+        const std::string variant = "sample rate " + std::to_string(sampleRate);
+
+        std::unique_ptr<GADS::FMIndex> fm;
+        reportResult(fullName, variant + " build from SA", measureMs([&]()
+            {
+                fm = std::make_unique<GADS::FMIndex>(sa, sampleRate);
+            }));
+        std::cout << fullName << " | " << variant << " memory | " << fm->memoryUsage() << " B ("
+            << static_cast<double>(fm->memoryUsage()) / text.size() << " n)" << std::endl;
+
+        reportResult(fullName, variant + " count", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                    checksum += fm->count(pattern);
+            }));
+
+        reportResult(fullName, variant + " locate first 10", measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                {
+                    const auto range = fm->findRange(pattern);
+                    for (GADS::IndexType order = range.first; order < std::min(range.second, range.first + 10); order++)
+                        checksum += fm->locate(order);
+                }
+            }));
+
+        reportResult(fullName, variant + " extract 100 chars", measureMs([&]()
+            {
+                for (GADS::IndexType q = 0; q < queryCount; q++)
+                    checksum += fm->extract(gen() % text.size(), 100).size();
+            }));
+    }
+    (void)checksum;
+}
+
+void benchDocuments(GADS::IndexType documentCount, GADS::IndexType documentLen, GADS::IndexType queryCount)
+{
+    const std::string fullName = "Generalized SA documents=" + std::to_string(documentCount) + " length=" + std::to_string(documentLen);
+
+    const std::string text = makeNaturalText(documentCount * documentLen);
+    GADS::GenericVector<std::string_view> documents(documentCount);
+    for (GADS::IndexType d = 0; d < documentCount; d++)
+        documents[d] = std::string_view(text).substr(d * documentLen, documentLen);
+
+    std::unique_ptr<GADS::GeneralizedSuffixArray> gsa;
+    reportResult(fullName, "build", measureMs([&]()
+        {
+            gsa = std::make_unique<GADS::GeneralizedSuffixArray>(documents);
+        }));
+    std::cout << fullName << " | memory | " << gsa->memoryUsage() << " B" << std::endl;
+
+    std::mt19937 gen(29);
+    GADS::GenericVector<std::string_view> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = documents[gen() % documentCount].substr(gen() % (documentLen - 8), 8);
+
+    GADS::IndexType checksum = 0;
+    reportResult(fullName, "documents containing", measureMs([&]()
+        {
+            for (const auto& pattern : patterns)
+                checksum += gsa->documentsContaining(pattern).size();
+        }));
+    reportResult(fullName, "top 10 documents", measureMs([&]()
+        {
+            for (const auto& pattern : patterns)
+                checksum += gsa->topDocuments<10>(pattern).size();
+        }));
+    (void)checksum;
+}
+
+// Shared fragment of two documents: the reversed text with a block of the first one planted in the middle
+std::pair<std::string, std::string> makeDocumentPair(GADS::IndexType len, GADS::IndexType sharedLen)
+{
+    const std::string first = makeRandomText(len, 4);
+    std::string second(first.rbegin(), first.rend());
+    second.replace(len / 2, sharedLen, first, len / 3, sharedLen);
+    return { first, second };
+}
+
+// Longest common substring by the generalized suffix array against the O(n * m) dynamic programming routines
+// on lengths they can handle, then repeats and common substrings of multi-megabyte documents
+void benchCommonSubstrings(GADS::IndexType dpLen, GADS::IndexType saLen, GADS::IndexType sharedLen)
+{
+    const auto small = makeDocumentPair(dpLen, sharedLen);
+    const std::string smallName = "Common substring n=" + std::to_string(dpLen);
+
+    GADS::IndexType length = 0;
+    reportResult(smallName, "longestCommonSubsequence", measureMs([&]()
+        {
+            length = GADS::longestCommonSubsequence(small.first, small.second);
+        }));
+    std::cout << smallName << " | subsequence length | " << length << ", table " << (dpLen + 1) * (dpLen + 1) * sizeof(size_t) << " B" << std::endl;
+
+    const GADS::MatchConfigGenericImpl config;
+    reportResult(smallName, "approximativeStringMatching", measureMs([&]()
+        {
+            length = GADS::approximativeStringMatching(small.first, small.second, config);
+        }));
+    std::cout << smallName << " | edit distance | " << length << std::endl;
+
+    reportResult(smallName, "generalized SA build + query", measureMs([&]()
+        {
+            length = GADS::GeneralizedSuffixArray(GADS::GenericVector<std::string>{ small.first, small.second }).longestCommonSubstring(2).length;
+        }));
+    std::cout << smallName << " | substring length | " << length << std::endl;
+
+    const auto large = makeDocumentPair(saLen, sharedLen);
+    const std::string largeName = "Common substring n=" + std::to_string(saLen);
+
+    std::unique_ptr<GADS::GeneralizedSuffixArray> gsa;
+    reportResult(largeName, "generalized SA build", measureMs([&]()
+        {
+            gsa = std::make_unique<GADS::GeneralizedSuffixArray>(GADS::GenericVector<std::string>{ large.first, large.second });
+        }));
+    GADS::CommonSubstring common;
+    reportResult(largeName, "longest common substring", measureMs([&]()
+        {
+            common = gsa->longestCommonSubstring(2);
+        }));
+    std::cout << largeName << " | substring length | " << common.length << ", table " << (saLen + 1) * (saLen + 1) * sizeof(size_t) << " B" << std::endl;
+
+    const std::string text = makeNaturalText(saLen);
+    const std::string textName = "Repeats natural language n=" + std::to_string(saLen);
+    for (const auto& support : { std::make_pair(GADS::LcpSupport::None, "no lcp"), std::make_pair(GADS::LcpSupport::BlockSparseTable, "block sparse table") })
+    {
+        const GADS::SuffixArray sa = GADS::SuffixArray::fromView(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support.first));
+
+        GADS::Repeat longest = { 0, 0, 0 };
+        reportResult(textName, std::string("longest repeated substring, ") + support.second, measureMs([&]()
+            {
+                longest = sa.longestRepeatedSubstring();
+            }));
+        GADS::IndexType repeatCount = 0;
+        reportResult(textName, std::string("maximal repeats >= 32, ") + support.second, measureMs([&]()
+            {
+                repeatCount = sa.maximalRepeats(32).size();
+            }));
+        std::cout << textName << " | longest " << longest.length << ", maximal repeats " << repeatCount << std::endl;
+    }
+}
+
+// Append latency with merges inline or in the background, merge against rebuild, and query cost per segment count
+void benchSegments(GADS::IndexType batchCount, GADS::IndexType batchLen, GADS::IndexType queryCount)
+{
+    const std::string fullName = "Segmented SA batches=" + std::to_string(batchCount) + " length=" + std::to_string(batchLen);
+
+    const std::string text = makeNaturalText(batchCount * batchLen);
+    GADS::GenericVector<std::string_view> batches(batchCount);
+    for (GADS::IndexType b = 0; b < batchCount; b++)
+        batches[b] = std::string_view(text).substr(b * batchLen, batchLen);
+
+    auto appendAll = [&](GADS::SegmentedSuffixArray& segmented)
+    {
+        double worstMs = 0;
+        const double totalMs = measureMs([&]()
+            {
+                for (const auto& batch : batches)
+                    worstMs = std::max(worstMs, measureMs([&]() { segmented.append(batch); }));
+            });
+        std::cout << fullName << " | worst append | " << worstMs << " ms" << std::endl;
+        return totalMs;
+    };
+
+    {
+        GADS::SegmentedSuffixArray segmented;
+        reportResult(fullName, "append, merges inline", appendAll(segmented));
+    }
+    {
+        GADS::ThreadPool pool(1);
+        GADS::SegmentedSuffixArray segmented(&pool);
+        reportResult(fullName, "append, merges in background", appendAll(segmented));
+        reportResult(fullName, "wait for merges", measureMs([&]() { segmented.waitForMerges(); }));
+    }
+
+    for (GADS::IndexType newerPercent : { 50, 5 })
+    {
+        const GADS::IndexType split = batchCount - batchCount * newerPercent / 100;
+        const GADS::GeneralizedSuffixArray older(GADS::GenericVector<std::string_view>(batches.begin(), batches.begin() + split));
+        const GADS::GeneralizedSuffixArray newer(GADS::GenericVector<std::string_view>(batches.begin() + split, batches.end()));
+        reportResult(fullName, "merge, newer " + std::to_string(newerPercent) + "%", measureMs([&]()
+            {
+                GADS::GeneralizedSuffixArray::merge(older, newer);
+            }));
+    }
+    reportResult(fullName, "rebuild", measureMs([&]() { GADS::GeneralizedSuffixArray rebuilt(batches); }));
+
+    std::mt19937 gen(31);
+    GADS::GenericVector<std::string_view> patterns(queryCount);
+    for (auto& pattern : patterns)
+        pattern = batches[gen() % batchCount].substr(gen() % (batchLen - 8), 8);
+
+    for (GADS::IndexType segmentCount : { 1, 4, 16, 64 })
+    {
+        GADS::SegmentedSuffixArray segmented(nullptr, 0);
+        for (GADS::IndexType s = 0; s < segmentCount; s++)
+            segmented.append(std::string_view(text).substr(text.size() * s / segmentCount, text.size() / segmentCount));
+
+        GADS::IndexType checksum = 0;
+        reportResult(fullName, "count, segments=" + std::to_string(segmentCount), measureMs([&]()
+            {
+                for (const auto& pattern : patterns)
+                    checksum += segmented.count(pattern);
+            }));
+        (void)checksum;
+    }
+}
+
+}
+
+int main()
+{
+    benchConstruction("random alphabet 4", makeRandomText(50000, 4), true);
+    benchConstruction("random alphabet 26", makeRandomText(50000, 26), true);
+    benchConstruction("natural language", makeNaturalText(50000), true);
+    benchConstruction("repetitive", makeRepetitiveText(20000), true);
+    benchConstruction("random alphabet 26", makeRandomText(2000000, 26), false);
+    benchConstruction("natural language", makeNaturalText(2000000), false);
+    benchConstruction("repetitive", makeRepetitiveText(2000000), false);
+
+    benchParallelConstruction("natural language", makeNaturalText(8000000));
+    benchParallelConstruction("random alphabet 4", makeRandomText(8000000, 4));
+
+    benchTokens("natural language", makeNaturalText(8000000), 200000);
+
+    benchRotations(1000000, 24);
+
+    benchLcpQueries("random alphabet 4", makeRandomText(1000000, 4), 1000000);
+    benchLcpQueries("natural language", makeNaturalText(1000000), 1000000);
+
+    benchIndexWidth("natural language", makeNaturalText(2000000), 200000);
+
+    benchPersistence("natural language", makeNaturalText(2000000), 200000);
+
+    benchOccurrences("repetitive", makeRepetitiveText(2000000), 200, 500);
+    benchOccurrences("natural language", makeNaturalText(2000000), 12, 200000);
+
+    benchBatchQueries("natural language", makeNaturalText(8000000), 1000000);
+
+    benchFMIndex("natural language", makeNaturalText(4000000), 20000);
+    benchFMIndex("random alphabet 4", makeRandomText(4000000, 4), 20000);
+
+    benchDocuments(100000, 40, 5000);
+
+    benchCommonSubstrings(4000, 4000000, 1000);
+
+    benchSegments(2000, 1000, 100000);
+}
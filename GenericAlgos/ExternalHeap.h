@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+	// I/O volume counters of ExternalHeap
+	struct ExternalHeapStats
+	{
+		IndexType bytesWritten = 0;
+		IndexType bytesRead = 0;
+		IndexType blocksWritten = 0;
+		IndexType blocksRead = 0;
+		IndexType runsWritten = 0; // Spilled runs including merged ones
+		IndexType runMerges = 0; // Multi-way merges of all runs into one
+	};
+
+	// External memory priority queue for queues bigger than available memory
+	// New elements go to an in-memory Heap, once it is full it is spilled to a temporary file as a sorted run
+	// written in large sequential blocks. Extraction multi-way merges block buffered fronts of all runs with the Heap.
+	// When the number of runs exceeds the memory budget all runs are merged into a single one.
+	// T must be trivially copyable to be stored in files. Comparer - same rules as for Heap.
+	template <typename T, typename Comparer = std::less<T> > class ExternalHeap
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "ExternalHeap requires trivially copyable elements");
+
+	public:
+
+		// Create empty queue using about memoryBudget bytes: half for the in-memory Heap,
+		// half for one read buffer of blockBytes per run
+		// Throws std::invalid_argument if the budget does not allow at least 2 runs
+		ExternalHeap(IndexType memoryBudget, IndexType blockBytes = 1 << 20) :
+			m_blockSize(std::max<IndexType>(1, blockBytes / sizeof(T))),
+			m_heapCapacity(memoryBudget / 2 / sizeof(T)),
+			m_maxRuns(memoryBudget / 2 / (m_blockSize * sizeof(T)))
+		{
+			if (m_maxRuns < 2 || m_heapCapacity == 0)
+				throw std::invalid_argument("Memory budget too small for given block size");
+		}
+
+		ExternalHeap(const ExternalHeap&) = delete;
+		ExternalHeap& operator = (const ExternalHeap&) = delete;
+
+		// Return number of elements in the queue
+		IndexType size() const { return m_size; }
+
+		// I/O volume counters
+		const ExternalHeapStats& ioStats() const { return m_stats; }
+
+		// Add new element, spills the in-memory Heap to disk when it is full
+		// Throws std::runtime_error on I/O failure
+		void insert(const T& item)
+		{
+			if (m_heap.size() == m_heapCapacity)
+				spillHeap();
+
+			m_heap.insert(item);
+			m_size++;
+		}
+
+		// Return the front element
+		// Throws std::out_of_range if the queue is empty
+		const T& top()
+		{
+			if (m_size == 0)
+				throw std::out_of_range("Heap is empty");
+
+			if (frontFromRuns())
+				return m_runFronts.top().first;
+			else
+				return m_heap.top();
+		}
+
+		// Remove and return the front element
+		// Throws std::out_of_range if the queue is empty, std::runtime_error on I/O failure
+		T extractTop()
+		{
+			if (m_size == 0)
+				throw std::out_of_range("Heap is empty");
+
+			m_size--;
+
+			if (frontFromRuns())
+				return extractRunFront();
+			else
+				return m_heap.extractTop();
+		}
+
+	private:
+
+		// Sorted run stored in a temporary file, read back through a block buffer
+		struct Run
+		{
+			std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{ nullptr, &std::fclose };
+			IndexType size = 0; // Number of elements in the file
+			IndexType readPos = 0; // Number of elements already read from the file
+			GenericVector<T> buffer;
+			IndexType bufferPos = 0;
+		};
+
+		// Front element of a run with run index
+		using RunFront = std::pair<T, IndexType>;
+
+		struct RunFrontComparer
+		{
+			bool operator()(const RunFront& a, const RunFront& b) const { return Comparer()(a.first, b.first); }
+		};
+
+		const IndexType m_blockSize; // Elements per block
+		const IndexType m_heapCapacity; // Elements in the in-memory Heap
+		const IndexType m_maxRuns;
+
+		IndexType m_size = 0;
+
+		Heap<T, Comparer> m_heap; // Recently inserted elements
+
+		GenericVector<Run> m_runs; // Exhausted runs are released, their slots are reused by new runs
+		Heap<RunFront, RunFrontComparer> m_runFronts; // Merge heap with the front of every not exhausted run
+
+		ExternalHeapStats m_stats;
+
+		// Checks if the front element belongs to the runs
+		bool frontFromRuns()
+		{
+			if (m_runFronts.size() == 0)
+				return false;
+			if (m_heap.size() == 0)
+				return true;
+			return !Comparer()(m_heap.top(), m_runFronts.top().first);
+		}
+
+		// Writes sorted run of elements delivered by given function to a new temporary file
+		template <typename NextFunc> void writeRun(IndexType count, NextFunc next)
+		{
+			Run run;
+			run.file.reset(std::tmpfile());
+			if (!run.file)
+				throw std::runtime_error("Cannot create temporary run file");
+
+			GenericVector<T> block;
+			block.reserve(std::min(count, m_blockSize));
+
+			for (IndexType written = 0; written < count; written += block.size())
+			{
+				block.clear();
+				const IndexType blockCount = std::min(count - written, m_blockSize);
+				for (IndexType i = 0; i < blockCount; i++)
+					block.push_back(next());
+
+				if (std::fwrite(block.data(), sizeof(T), block.size(), run.file.get()) != block.size())
+					throw std::runtime_error("Cannot write run file");
+
+				m_stats.bytesWritten += block.size() * sizeof(T);
+				m_stats.blocksWritten++;
+			}
+
+			std::rewind(run.file.get());
+			run.size = count;
+			m_stats.runsWritten++;
+
+			// Slot of an exhausted run is reused, so the indexes of the fronts stay valid
+			IndexType runIdx = 0;
+			while (runIdx < m_runs.size() && m_runs[runIdx].file)
+				runIdx++;
+			if (runIdx == m_runs.size())
+				m_runs.emplace_back();
+			m_runs[runIdx] = std::move(run);
+			if (count > 0)
+				m_runFronts.insert(nextFromRun(runIdx), runIdx);
+		}
+
+		// Reads next element of the run, refilling its buffer with a block if needed
+		T nextFromRun(IndexType runIdx)
+		{
+			Run& run = m_runs[runIdx];
+
+			if (run.bufferPos == run.buffer.size())
+			{
+				const IndexType blockCount = std::min(run.size - run.readPos, m_blockSize);
+				run.buffer.resize(blockCount);
+				if (std::fread(run.buffer.data(), sizeof(T), blockCount, run.file.get()) != blockCount)
+					throw std::runtime_error("Cannot read run file");
+
+				run.readPos += blockCount;
+				run.bufferPos = 0;
+				m_stats.bytesRead += blockCount * sizeof(T);
+				m_stats.blocksRead++;
+			}
+
+			return run.buffer[run.bufferPos++];
+		}
+
+		bool runExhausted(IndexType runIdx) const
+		{
+			const Run& run = m_runs[runIdx];
+			return run.readPos == run.size && run.bufferPos == run.buffer.size();
+		}
+
+		// Removes the smallest run front replacing it with the next element of the same run
+		T extractRunFront()
+		{
+			RunFront front = m_runFronts.extractTop();
+			const IndexType runIdx = front.second;
+
+			if (!runExhausted(runIdx))
+				m_runFronts.insert(nextFromRun(runIdx), runIdx);
+			else
+				m_runs[runIdx] = Run(); // Release file and buffer
+
+			if (m_runFronts.size() == 0)
+				m_runs.clear(); // All runs exhausted
+
+			return front.first;
+		}
+
+		// Writes content of the in-memory Heap as a new sorted run
+		void spillHeap()
+		{
+			// Only runs not exhausted yet hold a front and a read buffer
+			if (m_runFronts.size() >= m_maxRuns)
+				mergeRuns();
+
+			writeRun(m_heap.size(), [this]() { return m_heap.extractTop(); });
+		}
+
+		// Multi-way merges remaining elements of all runs into a single run
+		void mergeRuns()
+		{
+			IndexType remaining = m_runFronts.size();
+			for (const auto& run : m_runs)
+				remaining += (run.size - run.readPos) + (run.buffer.size() - run.bufferPos);
+
+			// Old runs are released while being merged, the merged run is added once all of them are exhausted
+			writeRun(remaining, [this]() { return extractRunFront(); });
+			m_stats.runMerges++;
+		}
+
+	}; // End of class ExternalHeap
+
+}
@@ -0,0 +1,170 @@
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "FMIndex.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+// Rows follow the suffix order after the $ row, last column of row r > 0 is the character before suffix of order r - 1
+GADS::FMIndex::FMIndex(const SuffixArray& suffixArray, IndexType sampleRate)
+    : m_size(suffixArray.size()), m_sampleRate(sampleRate), m_symbolStart(WaveletTree::AlphabetSize + 1, 0)
+{
+    if (sampleRate == 0)
+        throw std::invalid_argument("Sample rate must be positive");
+
+    const std::string_view text = suffixArray.getInputText();
+    const IndexType rows = m_size + 1;
+    const IndexType width = PackedIndexVct::widthBytes(m_size);
+
+    auto rowPosition = [&](IndexType row) { return (row == 0) ? m_size : suffixArray.getPosition(row - 1); };
+
+    GenericVector<uint8_t> bwt(rows);
+    GenericVector<bool> sampled(rows, false);
+    IndexType sampleCount = 0;
+    m_dollarRow = 0;
+    for (IndexType row = 0; row < rows; row++)
+    {
+        const IndexType pos = rowPosition(row);
+        if (pos == 0)
+            m_dollarRow = row;
+        else
+            bwt[row] = static_cast<uint8_t>(text[pos - 1]);
+
+        if (pos % m_sampleRate == 0)
+        {
+            sampled[row] = true;
+            sampleCount++;
+        }
+    }
+
+    m_bwt = WaveletTree(bwt);
+    m_sampled = RankBitVector(sampled);
+
+    m_samples = PackedIndexVct(sampleCount, width);
+    m_sampleRows = PackedIndexVct(m_size / m_sampleRate + 1, width);
+    for (IndexType row = 0, sample = 0; row < rows; row++)
+    {
+        if (sampled[row])
+        {
+            const IndexType pos = rowPosition(row);
+            m_samples.set(sample++, pos);
+            m_sampleRows.set(pos / m_sampleRate, row);
+        }
+    }
+
+    // Symbol counts of the text shifted by the $ row
+    for (auto c : text)
+        m_symbolStart[static_cast<uint8_t>(c) + 1]++;
+    m_symbolStart[0] = 1;
+    for (IndexType c = 1; c <= WaveletTree::AlphabetSize; c++)
+        m_symbolStart[c] += m_symbolStart[c - 1];
+}
+
+// LF mapping, $ is stored as symbol 0 and excluded from its ranks
+std::pair<uint8_t, GADS::IndexType> GADS::FMIndex::previous(IndexType row) const
+{
+    const auto symbolRank = m_bwt.accessRank(row);
+    IndexType rank = symbolRank.second;
+    if (symbolRank.first == 0 && m_dollarRow < row)
+        rank--;
+    return { symbolRank.first, m_symbolStart[symbolRank.first] + rank };
+}
+
+// Backward search narrowing the rows prefixed by growing suffixes of the pattern
+std::pair<GADS::IndexType, GADS::IndexType> GADS::FMIndex::findRange(std::string_view pattern) const
+{
+    if (pattern.empty())
+        return { 0, m_size };
+
+    IndexType lo = 0; // All rows including the $ row precede the last character of the pattern
+    IndexType hi = m_size + 1;
+
+    for (IndexType i = pattern.size(); i-- > 0 && lo < hi;)
+    {
+        const uint8_t c = static_cast<uint8_t>(pattern[i]);
+
+        IndexType rankLo = m_bwt.rank(c, lo);
+        IndexType rankHi = m_bwt.rank(c, hi);
+        if (c == 0)
+        {
+            rankLo -= (m_dollarRow < lo);
+            rankHi -= (m_dollarRow < hi);
+        }
+
+        lo = m_symbolStart[c] + rankLo;
+        hi = m_symbolStart[c] + rankHi;
+    }
+
+    // Rows prefixed by a non-empty pattern follow the $ row
+    if (lo >= hi)
+        return { lo - 1, lo - 1 };
+    return { lo - 1, hi - 1 };
+}
+
+GADS::IndexType GADS::FMIndex::searchSubstring(std::string_view substr) const
+{
+    if (substr.size() == 0)
+        throw std::out_of_range("Substring is empty");
+
+    const auto range = findRange(substr);
+    return (range.first < range.second) ? range.first : m_size;
+}
+
+// Walks back in the text until a sampled position
+GADS::IndexType GADS::FMIndex::locate(IndexType order) const
+{
+    if (order >= m_size)
+        throw std::out_of_range("Order out of range");
+
+    IndexType row = order + 1;
+    IndexType steps = 0;
+    while (!m_sampled[row])
+    {
+        row = previous(row).second;
+        steps++;
+    }
+    return m_samples[m_sampled.rank1(row)] + steps;
+}
+
+GADS::IndexVct GADS::FMIndex::locate(std::string_view pattern) const
+{
+    const auto range = findRange(pattern);
+
+    IndexVct positions;
+    positions.reserve(range.second - range.first);
+    for (IndexType order = range.first; order < range.second; order++)
+        positions.push_back(locate(order));
+    return positions;
+}
+
+GADS::IndexType GADS::FMIndex::rowOfPosition(IndexType pos) const
+{
+    return (pos == m_size) ? 0 : m_sampleRows[pos / m_sampleRate];
+}
+
+// Walks back from the first sampled position at or after the end of the substring
+std::string GADS::FMIndex::extract(IndexType pos, IndexType len) const
+{
+    if (pos > m_size)
+        throw std::out_of_range("Position out of range");
+
+    len = std::min(len, m_size - pos);
+    const IndexType end = pos + len;
+    IndexType start = std::min(m_size, (end + m_sampleRate - 1) / m_sampleRate * m_sampleRate);
+    IndexType row = rowOfPosition(start);
+
+    std::string result(len, '\0');
+    while (start > pos)
+    {
+        const auto prev = previous(row);
+        start--;
+        if (start < end)
+            result[start - pos] = static_cast<char>(prev.first);
+        row = prev.second;
+    }
+    return result;
+}
+
+GADS::IndexType GADS::FMIndex::memoryUsage() const
+{
+    return m_bwt.memoryUsage() + m_symbolStart.size() * sizeof(IndexType) + m_sampled.memoryUsage()
+        + m_samples.memoryUsage() + m_sampleRows.memoryUsage();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string_view>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "PackedIndexVector.h"
+#include "SuffixArray.h"
+#include "WaveletTree.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Compressed text index: Burrows-Wheeler transform of the text in a Huffman-shaped wavelet tree
+    // with suffix array samples. The text itself is not stored, it can be extracted from the index.
+    // Orders of suffixes are the same as in the SuffixArray the index was built from.
+    class FMIndex
+    {
+    public:
+
+        // Build index from a suffix array, every sampleRate-th text position is sampled for locate() and extract()
+        // Throws std::invalid_argument if sampleRate is 0
+        explicit FMIndex(const SuffixArray& suffixArray, IndexType sampleRate = 32);
+
+        // Length of the text
+        IndexType size() const { return m_size; }
+
+        // Verifies if given order is valid
+        bool indexValid(IndexType idx) const { return idx < m_size; }
+
+        // Range [lo, hi) of orders of suffixes starting with pattern, by backward search in O(m * H0)
+        // The range is empty if pattern does not occur
+        std::pair<IndexType, IndexType> findRange(std::string_view pattern) const;
+
+        // Checks if text contains a substring, returns order of the first suffix starting with it or size() if not found
+        // Throws std::out_of_range if substr is empty
+        IndexType searchSubstring(std::string_view substr) const;
+
+        // Number of occurrences of pattern in the text
+        IndexType count(std::string_view pattern) const
+        {
+            const auto range = findRange(pattern);
+            return range.second - range.first;
+        }
+
+        // Text position of the suffix of given order in O(sampleRate * H0)
+        // Throws std::out_of_range if order is not valid
+        IndexType locate(IndexType order) const;
+
+        // Text positions of all occurrences of pattern in lexicographic order of the suffixes
+        IndexVct locate(std::string_view pattern) const;
+
+        // Substring of the text of given length starting at given position in O((len + sampleRate) * H0)
+        // Throws std::out_of_range if pos is not valid
+        std::string extract(IndexType pos, IndexType len) const;
+
+        // Size of the index in bytes
+        IndexType memoryUsage() const;
+
+    private:
+
+        // Rows of the index are sorted rotations of text$, row 0 starts with $ and row r > 0 holds suffix of order r - 1
+
+        IndexType m_size; // Length of the text
+        IndexType m_sampleRate;
+
+        WaveletTree m_bwt; // Last column of the rows, $ stored as 0 at m_dollarRow
+        IndexType m_dollarRow;
+
+        IndexVct m_symbolStart; // Row of the first rotation starting with every symbol
+
+        RankBitVector m_sampled; // Rows of text positions divisible by the sample rate
+        PackedIndexVct m_samples; // Text positions of sampled rows, in row order
+        PackedIndexVct m_sampleRows; // Rows of text positions k * sampleRate
+
+        // Symbol of the row preceding the given row in text order, and the row of the preceding suffix (LF mapping)
+        std::pair<uint8_t, IndexType> previous(IndexType row) const;
+
+        IndexType rowOfPosition(IndexType pos) const;
+
+    }; // End of class FMIndex
+
+}
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "FuzzyDictionary.h"
+#include "Heap.h"
+#include "ThreadPool.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+// Nodes of a level are created in order from the sorted range of words of each node of the previous level.
+// Words equal to the prefix of a node come first in its range, the others are grouped by their next character.
+GADS::FuzzyDictionary::FuzzyDictionary(const GenericVector<std::string>& words)
+    : m_order(words.size())
+{
+    std::iota(m_order.begin(), m_order.end(), 0);
+    std::stable_sort(m_order.begin(), m_order.end(), [&words](IndexType a, IndexType b) { return words[a] < words[b]; });
+
+    // Root, the node of the empty prefix, and ranges of sorted words below every node
+    m_nodes.push_back({ 0, 0, '\0' });
+    GenericVector< std::pair<IndexType, IndexType> > ranges = { { 0, m_order.size() } };
+
+    for (IndexType depth = 0, levelBeg = 0; levelBeg < m_nodes.size(); depth++)
+    {
+        const IndexType levelEnd = m_nodes.size();
+        for (IndexType node = levelBeg; node < levelEnd; node++)
+        {
+            const auto [beg, end] = ranges[node];
+            IndexType w = beg;
+            while (w < end && words[m_order[w]].size() == depth)
+                w++;
+            m_wordStarts.push_back(beg);
+            m_wordEnds.push_back(w);
+
+            m_nodes[node].firstChild = m_nodes.size();
+            while (w < end)
+            {
+                const char c = words[m_order[w]][depth];
+                const IndexType groupBeg = w;
+                while (w < end && words[m_order[w]][depth] == c)
+                    w++;
+                m_nodes.push_back({ 0, 0, c });
+                ranges.emplace_back(groupBeg, w);
+            }
+            m_nodes[node].childCount = static_cast<uint32_t>(m_nodes.size() - m_nodes[node].firstChild);
+        }
+
+        m_maxDepth = depth;
+        levelBeg = levelEnd;
+    }
+}
+
+// Row at depth d holds distances of the prefix to all prefixes of the query. Cells j with |j - d| > bound
+// exceed the bound, so only the band is computed and its border cells are set to bound + 1 for the child rows.
+// Cells up to the bound are exact and the others stay above it, also after the bound drops during the search.
+template <typename Report>
+GADS::IndexType GADS::FuzzyDictionary::search(std::string_view query, IndexType bound, Report report) const
+{
+    const IndexType m = query.size();
+    const IndexType width = m + 1;
+
+    GenericVector<IndexType> rows((m_maxDepth + 1) * width);
+    std::iota(rows.begin(), rows.begin() + width, 0);
+    for (IndexType w = m_wordStarts[0]; w < m_wordEnds[0] && m <= bound; w++)
+        bound = report(m_order[w], m);
+
+    // Children not visited yet of the nodes on the path from the root, by depth of the parent
+    GenericVector< std::pair<IndexType, IndexType> > pending(m_maxDepth + 1);
+    pending[0] = { m_nodes[0].firstChild, m_nodes[0].firstChild + m_nodes[0].childCount };
+
+    IndexType visited = 1;
+    for (IndexType parentDepth = 0;;)
+    {
+        auto& children = pending[parentDepth];
+        if (children.first == children.second)
+        {
+            if (parentDepth == 0)
+                break;
+            parentDepth--;
+            continue;
+        }
+
+        const IndexType node = children.first++;
+        const IndexType depth = parentDepth + 1;
+        const IndexType lo = (depth > bound) ? depth - bound : 0;
+        const IndexType hi = std::min(m, depth + bound);
+        if (lo > m)
+        {
+            children.first = children.second; // Siblings are as deep
+            continue;
+        }
+
+        const char c = m_nodes[node].symbol;
+        const IndexType* up = &rows[parentDepth * width];
+        IndexType* row = &rows[depth * width];
+        const IndexType cap = bound + 1;
+        IndexType best = cap;
+        if (lo == 0)
+        {
+            row[0] = depth;
+            best = depth;
+        }
+        else
+            row[lo - 1] = cap;
+
+        for (IndexType j = std::max<IndexType>(lo, 1); j <= hi; j++)
+        {
+            const IndexType value = std::min({ up[j - 1] + (query[j - 1] != c), up[j] + 1, row[j - 1] + 1 });
+            row[j] = value;
+            best = std::min(best, value);
+        }
+        if (hi < m)
+            row[hi + 1] = cap;
+        visited++;
+
+        if (best > bound)
+            continue;
+
+        if (hi == m)
+        {
+            for (IndexType w = m_wordStarts[node]; w < m_wordEnds[node] && row[m] <= bound; w++)
+                bound = report(m_order[w], row[m]);
+        }
+
+        if (m_nodes[node].childCount > 0)
+        {
+            parentDepth = depth;
+            pending[depth] = { m_nodes[node].firstChild, m_nodes[node].firstChild + m_nodes[node].childCount };
+        }
+    }
+
+    return visited;
+}
+
+GADS::GenericVector<GADS::FuzzyMatch> GADS::FuzzyDictionary::findWithin(std::string_view query, IndexType k, IndexType* visitedNodes) const
+{
+    // No distance exceeds the longer of the query and the longest word, bigger bounds would overflow the band
+    k = std::min(k, std::max(query.size(), m_maxDepth));
+
+    GenericVector<FuzzyMatch> matches;
+    const IndexType visited = search(query, k, [&matches, k](IndexType word, IndexType distance)
+        {
+            matches.push_back({ word, distance });
+            return k;
+        });
+
+    std::sort(matches.begin(), matches.end());
+    if (visitedNodes != nullptr)
+        *visitedNodes += visited;
+    return matches;
+}
+
+// Once count words are kept the bound is the distance of the farthest one, a word at that distance is kept
+// only if its index is lower
+GADS::GenericVector<GADS::FuzzyMatch> GADS::FuzzyDictionary::findNearest(std::string_view query, IndexType count, IndexType* visitedNodes) const
+{
+    if (count == 0)
+        return {};
+
+    struct FartherFirst
+    {
+        bool operator()(const FuzzyMatch& a, const FuzzyMatch& b) const { return b < a; }
+    };
+    Heap<FuzzyMatch, FartherFirst> kept;
+
+    // No distance exceeds the longer of the query and the longest word
+    const IndexType limit = std::max(query.size(), m_maxDepth);
+    IndexType visited = 0;
+    for (IndexType bound = 0;; bound++)
+    {
+        kept = Heap<FuzzyMatch, FartherFirst>();
+        visited += search(query, bound, [&kept, count, bound](IndexType word, IndexType distance)
+            {
+                const FuzzyMatch match = { word, distance };
+                if (kept.size() < count)
+                    kept.insert(match);
+                else if (match < kept.top())
+                    kept.replaceTop(match);
+                return (kept.size() == count) ? std::min(bound, kept.top().distance) : bound;
+            });
+
+        if (kept.size() == count || bound == limit)
+            break;
+    }
+
+    GenericVector<FuzzyMatch> matches;
+    while (kept.size() > 0)
+        matches.push_back(kept.extractTop());
+    std::reverse(matches.begin(), matches.end());
+
+    if (visitedNodes != nullptr)
+        *visitedNodes += visited;
+    return matches;
+}
+
+// A few parts per thread balance queries of different cost
+template <typename Find>
+GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > GADS::FuzzyDictionary::findAll(const GenericVector<std::string_view>& queries,
+    ThreadPool* pool, IndexType* visitedNodes, Find find)
+{
+    GenericVector< GenericVector<FuzzyMatch> > results(queries.size());
+    std::atomic<IndexType> visited(0);
+
+    auto searchPart = [&](IndexType beg, IndexType end)
+    {
+        IndexType partVisited = 0;
+        for (IndexType i = beg; i < end; i++)
+            results[i] = find(queries[i], &partVisited);
+        visited += partVisited;
+    };
+
+    if (pool != nullptr && queries.size() > 1)
+        pool->parallelFor(queries.size(), 4 * pool->size(), searchPart);
+    else
+        searchPart(0, queries.size());
+
+    if (visitedNodes != nullptr)
+        *visitedNodes += visited;
+    return results;
+}
+
+GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > GADS::FuzzyDictionary::findWithin(const GenericVector<std::string_view>& queries,
+    IndexType k, ThreadPool* pool, IndexType* visitedNodes) const
+{
+    return findAll(queries, pool, visitedNodes, [this, k](std::string_view query, IndexType* visited) { return findWithin(query, k, visited); });
+}
+
+GADS::GenericVector< GADS::GenericVector<GADS::FuzzyMatch> > GADS::FuzzyDictionary::findNearest(const GenericVector<std::string_view>& queries,
+    IndexType count, ThreadPool* pool, IndexType* visitedNodes) const
+{
+    return findAll(queries, pool, visitedNodes, [this, count](std::string_view query, IndexType* visited) { return findNearest(query, count, visited); });
+}
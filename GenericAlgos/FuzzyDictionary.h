@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    class ThreadPool;
+
+    // Word of a dictionary at a unit cost edit distance from a query
+    struct FuzzyMatch
+    {
+        IndexType word; // Index in the list the dictionary was built from
+        IndexType distance;
+
+        bool operator == (const FuzzyMatch& other) const { return word == other.word && distance == other.distance; }
+
+        // Nearer words first, ties by index
+        bool operator < (const FuzzyMatch& other) const { return (distance != other.distance) ? distance < other.distance : word < other.word; }
+    };
+
+    // Index of a list of words for fuzzy search under the unit cost (Levenshtein) edit distance
+    // The words form a trie searched depth first. Every node extends the dynamic programming row of its parent
+    // by its character: rows of a common prefix are computed once for all words sharing it, and a subtree is pruned
+    // once all cells of its row exceed the bound. Only the cells of Ukkonen's band of the bound are computed,
+    // O(k) per visited node. Children of a node are stored contiguously, so its pruned children are read in sequence.
+    class FuzzyDictionary
+    {
+    public:
+
+        // Build the trie of words, equal words are reported together
+        explicit FuzzyDictionary(const GenericVector<std::string>& words);
+
+        // Number of words the dictionary was built from
+        IndexType size() const { return m_order.size(); }
+
+        // Number of trie nodes, the root included
+        IndexType nodeCount() const { return m_nodes.size(); }
+
+        // Words at distance at most k from query, sorted by distance and index
+        // visitedNodes, if given, is increased by the number of trie nodes whose row was computed
+        GenericVector<FuzzyMatch> findWithin(std::string_view query, IndexType k, IndexType* visitedNodes = nullptr) const;
+
+        // count nearest words to query, sorted by distance and index, all words if there are fewer of them
+        // Searches with bounds 0, 1, 2, ... until count words are found, the bound then drops to the distance
+        // of the farthest word kept. Visited nodes grow several times with every step of the bound, so the searches
+        // before the last one add a small part of its work.
+        GenericVector<FuzzyMatch> findNearest(std::string_view query, IndexType count, IndexType* visitedNodes = nullptr) const;
+
+        // findWithin() for every query, with a thread pool contiguous parts of the batch are searched in parallel
+        GenericVector< GenericVector<FuzzyMatch> > findWithin(const GenericVector<std::string_view>& queries, IndexType k,
+            ThreadPool* pool = nullptr, IndexType* visitedNodes = nullptr) const;
+
+        // findNearest() for every query, with a thread pool contiguous parts of the batch are searched in parallel
+        GenericVector< GenericVector<FuzzyMatch> > findNearest(const GenericVector<std::string_view>& queries, IndexType count,
+            ThreadPool* pool = nullptr, IndexType* visitedNodes = nullptr) const;
+
+    private:
+
+        // Fields read for every visited node
+        struct Node
+        {
+            IndexType firstChild;
+            uint32_t childCount;
+            char symbol; // Added to the prefix of the parent
+        };
+
+        GenericVector<Node> m_nodes; // Level order from the root, children in sorted order of their symbols
+        IndexVct m_wordStarts; // Words ending at node i are m_order[m_wordStarts[i]] to m_order[m_wordEnds[i] - 1]
+        IndexVct m_wordEnds;
+        IndexVct m_order; // Indexes of the words in sorted order
+
+        IndexType m_maxDepth = 0;
+
+        // Depth first search with the bound, matches are passed to report(word, distance), which returns the new bound
+        template <typename Report> IndexType search(std::string_view query, IndexType bound, Report report) const;
+
+        template <typename Find> static GenericVector< GenericVector<FuzzyMatch> > findAll(const GenericVector<std::string_view>& queries,
+            ThreadPool* pool, IndexType* visitedNodes, Find find);
+
+    }; // End of class FuzzyDictionary
+
+}
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include "GeneralAlgorithmsAndDataStructures.h"
+#include "StringDistance.h"
 
 namespace GADS = GeneralAlgorithmsAndDataStructures;
 
@@ -196,109 +197,78 @@ void GADS::SubsetGenerator::nextSubsetMask()
 }
 
 
-namespace // longestCommonSubsequence related
+namespace // approximativeStringMatching related
 {
 
-typedef GADS::GenericVector<GADS::IndexType> Row;
-typedef GADS::GenericVector <Row> Table;
-
-typedef GADS::GenericSet <std::string> Sequences;
-
-
-// Recovers the longest subsequence from the tracking table
-Sequences backtrackAllLongestSubsequences(const Table& t, const std::string& s1, const std::string& s2, GADS::IndexType i, GADS::IndexType j, bool matchingCharsFound = false)
+// Distinct characters of s in order of their first occurrence
+std::string distinctCharacters(const std::string& s)
 {
-    Sequences result;
-
-    if ((i == 0) || (j == 0))
+    GADS::GenericVector<bool> seen(std::numeric_limits<unsigned char>::max() + 1, false);
+    std::string result;
+    for (const char c : s)
     {
-        if (matchingCharsFound)
-            result.insert(std::string());
-    }
-    else
-    {
-        if (s1[i - 1] == s2[j - 1]) // Matching characters
+        if (!seen[static_cast<unsigned char>(c)])
         {
-            const Sequences& prefixes = backtrackAllLongestSubsequences(t, s1, s2, i - 1, j - 1, true);
-
-            for (Sequences::iterator it = prefixes.begin(); it != prefixes.end(); ++it)
-            {
-                result.insert (*it + s1[i - 1]); // Append matching character to collected prefix strings
-            }
+            seen[static_cast<unsigned char>(c)] = true;
+            result += c;
         }
-        
-        else
-        {
-            if (t[i][j - 1] >= t[i - 1][j]) // Insert element [i, j - 1]
-            {
-                const Sequences& prefixes = backtrackAllLongestSubsequences(t, s1, s2, i, j - 1, matchingCharsFound);
-                result.insert(prefixes.begin(), prefixes.end());
-            }
+    }
+    return result;
+}
 
-            if (t[i - 1][j] >= t[i][j - 1]) // Insert element [i - 1, j]
-            {
-                const Sequences& prefixes = backtrackAllLongestSubsequences(t, s1, s2, i - 1, j, matchingCharsFound);
-                result.insert(prefixes.begin(), prefixes.end());
-            }
+// Checks if config charges the unit costs of MatchConfigGenericImpl to all characters of chars1 and chars2
+bool hasUnitCosts(const GADS::MatchConfig& config, const std::string& chars1, const std::string& chars2)
+{
+    for (const char c1 : chars1)
+    {
+        if (config.deleteCost(c1) != 1)
+            return false;
+        for (const char c2 : chars2)
+        {
+            if (config.matchCost(c1, c2) != ((c1 == c2) ? 0 : 1))
+                return false;
         }
     }
-
-    return result;
+    for (const char c2 : chars2)
+    {
+        if (config.insertCost(c2) != 1)
+            return false;
+    }
+    return true;
 }
 
 }
 
 // Finds the length 'and the sequences if container provided) of the longeset common subsequences of strings s1 and s2
-GADS::IndexType GADS::longestCommonSubsequence(const std::string& s1, const std::string& s2, GenericSet < std::string >* sequences)
+GADS::IndexType GADS::longestCommonSubsequence(const std::string& s1, const std::string& s2, GenericSet < std::string >* sequences,
+    IndexType maxSequences)
 {
 
     // Input check
     if (( s1.length() == 0) || ( s2.length() == 0))
         return 0;
 
-    // Table dimensions
-    GADS::IndexType s1Length = s1.length() + 1; // Empty 0th element
-    GADS::IndexType s2Length = s2.length() + 1; // Empty 0th element
-
-    // Table initialization
-    Table t(s1Length);
-    for (auto& row: t)
-        row.resize(s2Length);
- 
-    // All table elements are filled with 0
+    // Length only, no table needed
+    if (sequences == nullptr)
+        return longestCommonSubsequenceLength(s1, s2);
 
-    // Main loop
-    for (GADS::IndexType i = 1; i < s1Length; i++) // For every char in s1
-    {
-        for (GADS::IndexType j = 1; j < s2Length; j++) // Compare with a char in s2
-        {
-            if (s1[i - 1] == s2[j - 1]) // Matching case, char in s2 already was present in s1
-                t[i][j] = t[i - 1][j - 1] + 1; // Matching score at given position is increased
-            else
-                t[i][j] = std::max(t[i][j - 1], t[i - 1][j]); // Matching score at given position is copied from the last highest score
-        }
-    }
-
-    GADS::IndexType longestCommonSubsequenceLength = t[s1Length - 1][s2Length - 1];
-
-    if ( (sequences != nullptr) && (longestCommonSubsequenceLength > 0) ) // Store discovered subsequences
-    {
-        *sequences = backtrackAllLongestSubsequences(t, s1, s2, s1Length - 1, s2Length - 1);
-    }
+    // Distinct subsequences up to the cap, their number may be exponential
+    const GenericVector<std::string> found = longestCommonSubsequences(s1, s2, maxSequences);
+    if (found.empty())
+        return 0;
 
-    return longestCommonSubsequenceLength;
+    *sequences = GenericSet<std::string>(found.begin(), found.end());
+    return found.front().size();
 
 }
 
-// Implementation of MatchConfigGenericImpl
-
+// Deprecated hooks of MatchConfig
 
-// Creates and inits table of matching results
-Table GADS::MatchConfigGenericImpl::createTable(GADS::IndexType tableD1, GADS::IndexType tableD2) const
+GADS::MatchConfig::Table GADS::MatchConfig::createTable(IndexType tableD1, IndexType tableD2) const
 {
     Table t(tableD1);
 
-    for (GADS::IndexType i = 0; i < tableD1; i++)
+    for (IndexType i = 0; i < tableD1; i++)
     {
         t[i].resize(tableD2);
 
@@ -315,6 +285,15 @@ Table GADS::MatchConfigGenericImpl::createTable(GADS::IndexType tableD1, GADS::I
     return t;
 }
 
+GADS::IndexType GADS::MatchConfig::getResult(const Table& t) const
+{
+    return t.back().back();
+}
+
+
+// Implementation of MatchConfigGenericImpl
+
+
 // Cost of matching 2 characters
 GADS::ValueType GADS::MatchConfigGenericImpl::matchCost(char c1, char c2) const
 {
@@ -338,12 +317,6 @@ GADS::ValueType GADS::MatchConfigGenericImpl::deleteCost(char c) const
     return 1;
 }
 
-// Find the final result
-GADS::IndexType GADS::MatchConfigGenericImpl::getResult(const Table& t) const
-{
-    return t.back().back();
-}
-
 
 
 // Finds best match of strings s1 and s2 parametrized by object MatchConfig
@@ -351,36 +324,17 @@ GADS::IndexType GADS::MatchConfigGenericImpl::getResult(const Table& t) const
 GADS::IndexType GADS::approximativeStringMatching(const std::string& s1, const std::string& s2,
     const MatchConfig& matchConfig, GenericSet < std::string >* sequences)
 {
-    // Table dimensions
-    GADS::IndexType s1Length = s1.length() + 1; // Empty 0th element
-    GADS::IndexType s2Length = s2.length() + 1; // Empty 0th element
-
-    MatchConfig::Table t = matchConfig.createTable(s1Length, s2Length);
-
-    // Main loop
-    for (GADS::IndexType i = 1; i < s1Length; i++) // For every char in s1
+    // Unit costs on all characters present are the Levenshtein distance, bit-parallel without a traceback
+    if (sequences == nullptr)
     {
-        for (GADS::IndexType j = 1; j < s2Length; j++) // Compare with a char in s2
-        {
-            // Getting costs of all operations in current context
-            GADS::GenericVector<IndexType> operCost;
-            operCost.reserve(matchConfig.CompareOperCount);
-            operCost.push_back(t[i - 1][j - 1] + matchConfig.matchCost(s1[i - 1], s2[j - 1])); // matching
-            operCost.push_back(t[i][j - 1] + matchConfig.insertCost(s1[i - 1])); // inserting
-            operCost.push_back(t[i - 1][j] + matchConfig.deleteCost(s1[i - 1])); // deleting
-            assert(operCost.size() == matchConfig.CompareOperCount);
-
-            // Choose and store the smallest cost
-            for (GADS::IndexType k = 0; k < operCost.size(); k++)
-            {
-                if (operCost[k] < t[i][j])
-                    t[i][j] = operCost[k];
-            }
-        }
+        const std::string chars1 = distinctCharacters(s1);
+        const std::string chars2 = distinctCharacters(s2);
+        if (chars1.size() * chars2.size() <= s1.size() * s2.size() && hasUnitCosts(matchConfig, chars1, chars2))
+            return editDistance(s1, s2);
     }
 
-    return matchConfig.getResult(t);
-
+    // Virtual costs through the policy kernel of StringDistance.h
+    return approximativeStringMatching(std::string_view(s1), std::string_view(s2), MatchConfigCostPolicy(matchConfig), sequences);
 }
 
 
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 
 
 namespace GeneralAlgorithmsAndDataStructures
@@ -57,6 +58,9 @@ namespace GeneralAlgorithmsAndDataStructures
 
     constexpr int NotFound = -1;
 
+    // Subsequences collected by longestCommonSubsequence() unless another cap is given
+    constexpr IndexType DefaultMaxSubsequences = 1000;
+
 
     // Iterator based implementation of the Lomuto partition algorithm in range [beg, end), takes initial pivot position as parameter 
     // Returns position of the pivot in the partitioned list
@@ -360,10 +364,16 @@ namespace GeneralAlgorithmsAndDataStructures
 
     // Finds length of the longest common subsequences of strings s1 and s2
     // If container was passed as a parameter it will contain matching subsequence or an empty string if there is no one
-    IndexType longestCommonSubsequence(const std::string& s1, const std::string& s2, GenericSet < std::string >* sequences = nullptr);
+    // Without container only the length is computed by longestCommonSubsequenceLength() from StringDistance.h,
+    // the container is filled by longestCommonSubsequences() with the first maxSequences of them in lexicographic order,
+    // see longestCommonSubsequenceWitness() for a single one
+    IndexType longestCommonSubsequence(const std::string& s1, const std::string& s2, GenericSet < std::string >* sequences = nullptr,
+        IndexType maxSequences = DefaultMaxSubsequences);
 
 
     // Interface for configuring matching in func approximativeStringMatching
+    // Only the costs are configurable: borders of the table are sums of insert and delete costs and the result
+    // is its last cell.
     class MatchConfig
     {
     public:
@@ -372,36 +382,43 @@ namespace GeneralAlgorithmsAndDataStructures
 
         static constexpr IndexType CompareOperCount = 3; // match, insert, delete
 
-        // Creates and inits table of matching results
-        virtual Table createTable(IndexType tableD1, IndexType tableD2) const = 0;
+        // Creates and inits table of unit cost matching results
+        // Not called by approximativeStringMatching(), kept for existing overrides
+        [[deprecated("approximativeStringMatching() does not call createTable()")]]
+        virtual Table createTable(IndexType tableD1, IndexType tableD2) const;
 
-        // Cost of matching 2 characters
+        // Cost of matching character c1 of s1 with character c2 of s2
         virtual ValueType matchCost(char c1, char c2) const = 0;
 
-        // Cost of inserting given character
+        // Cost of inserting given character of s2
         virtual ValueType insertCost(char c) const = 0;
 
-        // Cost of deleting given character
+        // Cost of deleting given character of s1
         virtual ValueType deleteCost(char c) const = 0;
 
-        // Find the final result
-        virtual IndexType getResult(const Table& t) const = 0;
+        // Last cell of the table
+        // Not called by approximativeStringMatching(), kept for existing overrides
+        [[deprecated("approximativeStringMatching() does not call getResult()")]]
+        virtual IndexType getResult(const Table& t) const;
 
     };
 
+    // Unit costs, the Levenshtein distance
     class MatchConfigGenericImpl : public MatchConfig
     {
     public:
-        Table createTable(IndexType tableD1, IndexType tableD2) const override;
         ValueType matchCost(char c1, char c2) const override;
         ValueType insertCost(char c) const override;
         ValueType deleteCost(char c) const override;
-        IndexType getResult(const Table& t) const override;
 
     };
 
     // Finds best match of strings s1 and s2 parametrized by object MatchConfig
     // If container was passed as a parameter it will contain matching subsequence or an empty string if there is no one
+    // Runs the approximativeStringMatching() kernel of StringDistance.h through MatchConfigCostPolicy, insertions
+    // are charged insertCost() of the inserted character of s2. Prefer a cost policy for speed, every cell makes
+    // three virtual calls here. Without a container, if the costs of all characters of s1 and s2 are unit costs
+    // and checking them is cheaper than the table, the bit-parallel editDistance() is used.
     IndexType approximativeStringMatching(const std::string& s1, const std::string& s2, const MatchConfig& matchConfig, GenericSet < std::string >* sequences = nullptr);
 
 
@@ -0,0 +1,360 @@
+#include <deque>
+#include <limits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "GeneralizedSuffixArray.h"
+#include "SuffixSorting.h"
+#include "WaveletTree.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+namespace
+{
+
+    constexpr char SeparatorByte = '\0';
+
+    // Symbols of the concatenation: separator of document d is d, character c is documentCount + c
+    // Suffixes of separators sort first, the remaining ones are copied in order
+    template <typename Index> GADS::PackedIndexVct sortDocumentSuffixes(const std::string& text, const GADS::GenericVector<bool>& separators,
+        GADS::IndexType documentCount, GADS::IndexType width)
+    {
+        GADS::GenericVector<uint32_t> symbols(text.size());
+        for (GADS::IndexType i = 0, doc = 0; i < text.size(); i++)
+            symbols[i] = separators[i] ? static_cast<uint32_t>(doc++) : static_cast<uint32_t>(documentCount + static_cast<unsigned char>(text[i]));
+
+        constexpr GADS::IndexType ByteCount = std::numeric_limits<unsigned char>::max() + 1;
+        const GADS::GenericVector<Index> sa = GADS::induceSortSuffixes<Index>(symbols.data(), symbols.size(), documentCount + ByteCount);
+
+        GADS::PackedIndexVct result(text.size() - documentCount, width);
+        for (GADS::IndexType i = documentCount; i < sa.size(); i++)
+            result.set(i - documentCount, sa[i]);
+        return result;
+    }
+
+} // End of anonymous namespace
+
+GADS::GeneralizedSuffixArray::GeneralizedSuffixArray(const GenericVector<std::string_view>& documents)
+{
+    constexpr IndexType ByteCount = std::numeric_limits<unsigned char>::max() + 1;
+    if (documents.size() > std::numeric_limits<uint32_t>::max() - ByteCount)
+        throw std::length_error("Too many documents");
+
+    IndexType totalSize = documents.size();
+    for (const auto& doc : documents)
+        totalSize += doc.size();
+
+    const IndexType width = PackedIndexVct::widthBytes(totalSize);
+
+    m_text.reserve(totalSize);
+    m_docStarts = PackedIndexVct(documents.size(), width);
+    GenericVector<bool> separators(totalSize, false);
+    for (IndexType d = 0; d < documents.size(); d++)
+    {
+        m_docStarts.set(d, m_text.size());
+        m_text += documents[d];
+        separators[m_text.size()] = true;
+        m_text += SeparatorByte;
+    }
+    m_separators = RankBitVector(separators);
+
+    if (totalSize < std::numeric_limits<uint32_t>::max())
+        m_suffixArray = sortDocumentSuffixes<uint32_t>(m_text, separators, documents.size(), width);
+    else
+        m_suffixArray = sortDocumentSuffixes<uint64_t>(m_text, separators, documents.size(), width);
+}
+
+// Gap array merge: rows of older are its separator suffixes in id order followed by its suffix array.
+// A suffix of newer ends with a separator following all separators of older, so it is preceded by all of them.
+// Number of rows of older smaller than c + X is C[c] + rank of c among last symbols of rows smaller than X.
+GADS::GeneralizedSuffixArray GADS::GeneralizedSuffixArray::merge(const GeneralizedSuffixArray& older, const GeneralizedSuffixArray& newer)
+{
+    constexpr IndexType ByteCount = std::numeric_limits<unsigned char>::max() + 1;
+    if (older.documentCount() + newer.documentCount() > std::numeric_limits<uint32_t>::max() - ByteCount)
+        throw std::length_error("Too many documents");
+
+    const IndexType olderDocs = older.documentCount();
+    const IndexType olderRows = older.m_text.size();
+
+    auto rowPosition = [&older, olderDocs](IndexType row)
+    {
+        return (row < olderDocs) ? older.docEnd(row) : older.m_suffixArray[row - olderDocs];
+    };
+
+    // Symbols preceding the rows, rows preceded by a separator or the text start are stored as 0 and marked
+    GenericVector<uint8_t> bwt(olderRows, 0);
+    GenericVector<bool> noCharacter(olderRows, false);
+    for (IndexType row = 0; row < olderRows; row++)
+    {
+        const IndexType pos = rowPosition(row);
+        if (pos == 0 || older.m_separators[pos - 1])
+            noCharacter[row] = true;
+        else
+            bwt[row] = static_cast<uint8_t>(older.m_text[pos - 1]);
+    }
+    const WaveletTree bwtTree(bwt);
+    const RankBitVector noCharacterRows(noCharacter);
+
+    auto rankCharacter = [&](uint8_t c, IndexType row)
+    {
+        const IndexType rank = bwtTree.rank(c, row);
+        return (c == 0) ? rank - noCharacterRows.rank1(row) : rank;
+    };
+
+    // First row starting with every character
+    IndexVct symbolStart(ByteCount + 1, 0);
+    for (IndexType pos = 0; pos < olderRows; pos++)
+    {
+        if (!older.m_separators[pos])
+            symbolStart[static_cast<uint8_t>(older.m_text[pos]) + 1]++;
+    }
+    symbolStart[0] = olderDocs;
+    for (IndexType c = 1; c <= ByteCount; c++)
+        symbolStart[c] += symbolStart[c - 1];
+
+    // Number of rows of older smaller than every suffix of newer, by backward search over every document of newer
+    IndexVct olderRank(newer.m_text.size());
+    for (IndexType d = 0; d < newer.documentCount(); d++)
+    {
+        IndexType rank = olderDocs;
+        for (IndexType i = newer.docEnd(d); i-- > newer.m_docStarts[d];)
+        {
+            const uint8_t c = static_cast<uint8_t>(newer.m_text[i]);
+            rank = symbolStart[c] + rankCharacter(c, rank);
+            olderRank[i] = rank;
+        }
+    }
+
+    GeneralizedSuffixArray result;
+    result.m_text = older.m_text + newer.m_text;
+
+    const IndexType width = PackedIndexVct::widthBytes(result.m_text.size());
+
+    GenericVector<bool> separators(result.m_text.size());
+    for (IndexType pos = 0; pos < result.m_text.size(); pos++)
+        separators[pos] = (pos < olderRows) ? older.m_separators[pos] : newer.m_separators[pos - olderRows];
+    result.m_separators = RankBitVector(separators);
+
+    result.m_docStarts = PackedIndexVct(olderDocs + newer.documentCount(), width);
+    for (IndexType d = 0; d < result.m_docStarts.size(); d++)
+        result.m_docStarts.set(d, (d < olderDocs) ? older.m_docStarts[d] : newer.m_docStarts[d - olderDocs] + olderRows);
+
+    // Suffixes of newer keep their order and are placed after the rows of older smaller than them
+    result.m_suffixArray = PackedIndexVct(older.size() + newer.size(), width);
+    IndexType out = 0;
+    IndexType row = olderDocs;
+    for (IndexType order = 0; order < newer.size(); order++)
+    {
+        const IndexType pos = newer.m_suffixArray[order];
+        for (; row < olderRank[pos]; row++)
+            result.m_suffixArray.set(out++, rowPosition(row));
+        result.m_suffixArray.set(out++, pos + olderRows);
+    }
+    for (; row < olderRows; row++)
+        result.m_suffixArray.set(out++, rowPosition(row));
+
+    return result;
+}
+
+std::pair<GADS::IndexType, GADS::IndexType> GADS::GeneralizedSuffixArray::findRange(std::string_view pattern) const
+{
+    const IndexType lo = findBound(pattern, false, 0);
+    return { lo, findBound(pattern, true, lo) };
+}
+
+// Binary search starting comparisons after characters matched by both window borders
+// A separator ends the suffix, patterns never match it
+GADS::IndexType GADS::GeneralizedSuffixArray::findBound(std::string_view pattern, bool upper, IndexType left) const
+{
+    const IndexType M = pattern.size();
+
+    auto code = [](char c) { return static_cast<unsigned char>(c); };
+
+    IndexType right = m_suffixArray.size();
+    IndexType l = 0; // Match of the pattern with suffix left - 1, underestimated by 0 initially
+    IndexType r = 0; // Match of the pattern with suffix right
+
+    while (left < right)
+    {
+        const IndexType mid = left + (right - left) / 2;
+        const IndexType pos = m_suffixArray[mid];
+
+        IndexType match = std::min(l, r);
+        while (match < M && m_text[pos + match] == pattern[match] && (m_text[pos + match] != SeparatorByte || !m_separators[pos + match]))
+            match++;
+
+        bool precedes;
+        if (match == M)
+            precedes = upper; // Suffix starts with pattern
+        else if (m_text[pos + match] == SeparatorByte && m_separators[pos + match])
+            precedes = true; // Suffix ends before the pattern
+        else
+            precedes = code(m_text[pos + match]) < code(pattern[match]);
+
+        if (precedes)
+        {
+            left = mid + 1;
+            l = match;
+        }
+        else
+        {
+            right = mid;
+            r = match;
+        }
+    }
+
+    return left;
+}
+
+GADS::GenericVector<GADS::DocumentPosition> GADS::GeneralizedSuffixArray::occurrences(std::string_view pattern) const
+{
+    const auto range = findRange(pattern);
+
+    GenericVector<DocumentPosition> result;
+    result.reserve(range.second - range.first);
+    for (IndexType order = range.first; order < range.second; order++)
+        result.push_back(getPosition(order));
+    return result;
+}
+
+GADS::IndexVct GADS::GeneralizedSuffixArray::documentsContaining(std::string_view pattern) const
+{
+    IndexVct result;
+    for (const auto& frequency : documentFrequencies(pattern))
+        result.push_back(frequency.document);
+    return result;
+}
+
+// Documents of all occurrences are sorted and counted in runs
+GADS::GenericVector<GADS::DocumentFrequency> GADS::GeneralizedSuffixArray::documentFrequencies(std::string_view pattern) const
+{
+    const auto range = findRange(pattern);
+
+    IndexVct docs;
+    docs.reserve(range.second - range.first);
+    for (IndexType order = range.first; order < range.second; order++)
+        docs.push_back(m_separators.rank1(m_suffixArray[order]));
+    std::sort(docs.begin(), docs.end());
+
+    GenericVector<DocumentFrequency> result;
+    for (IndexType i = 0; i < docs.size(); i++)
+    {
+        if (i == 0 || docs[i] != docs[i - 1])
+            result.push_back({ docs[i], 0 });
+        result.back().frequency++;
+    }
+    return result;
+}
+
+// Every window of suffix orders [lo, hi] covering minDocuments documents shares a prefix of the minimum lcp
+// inside of it. For every hi only the shortest such window is checked, its minimum is kept in a monotonic queue.
+GADS::CommonSubstring GADS::GeneralizedSuffixArray::longestCommonSubstring(IndexType minDocuments) const
+{
+    if (minDocuments < 2 || minDocuments > documentCount())
+        throw std::invalid_argument("Document count out of range");
+
+    const IndexType n = m_suffixArray.size();
+    GenericVector<uint32_t> documents;
+    const IndexVct lcp = buildLcpArray(documents);
+
+    IndexVct windowCount(documentCount(), 0);
+    IndexType covered = 0;
+    std::deque<IndexType> minimum; // Orders in (lo, hi] with increasing lcp
+
+    IndexType bestLength = 0;
+    IndexType bestOrder = 0;
+    uint32_t loDocument = (n > 0) ? documents[0] : 0;
+    for (IndexType lo = 0, hi = 0; hi < n; hi++)
+    {
+        if (windowCount[documents[hi]]++ == 0)
+            covered++;
+        if (hi > lo)
+        {
+            while (!minimum.empty() && lcp[minimum.back()] >= lcp[hi])
+                minimum.pop_back();
+            minimum.push_back(hi);
+        }
+
+        for (; lo < hi && (windowCount[loDocument] > 1 || covered > minDocuments); lo++)
+        {
+            if (--windowCount[loDocument] == 0)
+                covered--;
+            if (!minimum.empty() && minimum.front() == lo + 1)
+                minimum.pop_front();
+            loDocument = documents[lo + 1];
+        }
+
+        if (covered >= minDocuments && lcp[minimum.front()] > bestLength)
+        {
+            bestLength = lcp[minimum.front()];
+            bestOrder = hi;
+        }
+    }
+
+    CommonSubstring result = { bestLength, {} };
+    if (bestLength == 0)
+        return result;
+
+    // All suffixes starting with the substring, the first occurrence of every document is kept
+    IndexType lo = bestOrder;
+    while (lo > 0 && lcp[lo] >= bestLength)
+        lo--;
+    IndexType hi = bestOrder + 1;
+    while (hi < n && lcp[hi] >= bestLength)
+        hi++;
+
+    for (IndexType order = lo; order < hi; order++)
+        result.occurrences.push_back(getPosition(order));
+    std::sort(result.occurrences.begin(), result.occurrences.end(), [](const DocumentPosition& a, const DocumentPosition& b)
+        {
+            return (a.document != b.document) ? (a.document < b.document) : (a.offset < b.offset);
+        });
+    result.occurrences.erase(std::unique(result.occurrences.begin(), result.occurrences.end(),
+        [](const DocumentPosition& a, const DocumentPosition& b) { return a.document == b.document; }), result.occurrences.end());
+
+    return result;
+}
+
+// Kasai's algorithm over positions of every document, a separator ends the common prefix
+// and the carried length restarts at the next document
+GADS::IndexVct GADS::GeneralizedSuffixArray::buildLcpArray(GenericVector<uint32_t>& documents) const
+{
+    const IndexType n = m_suffixArray.size();
+
+    IndexVct rank(m_text.size(), 0);
+    for (IndexType order = 0; order < n; order++)
+        rank[m_suffixArray[order]] = order;
+
+    auto isSeparator = [this](IndexType pos) { return m_separators[pos]; };
+
+    IndexVct lcp(n, 0);
+    documents.assign(n, 0);
+    IndexType len = 0;
+    uint32_t doc = 0;
+    for (IndexType pos = 0; pos < m_text.size(); pos++)
+    {
+        if (m_text[pos] == SeparatorByte && isSeparator(pos))
+        {
+            doc++;
+            len = 0;
+            continue;
+        }
+
+        const IndexType r = rank[pos];
+        documents[r] = doc;
+        if (r == 0)
+        {
+            len = 0;
+            continue;
+        }
+
+        const IndexType prev = m_suffixArray[r - 1];
+        while (m_text[pos + len] == m_text[prev + len] && (m_text[pos + len] != SeparatorByte || (!isSeparator(pos + len) && !isSeparator(prev + len))))
+            len++;
+
+        lcp[r] = len;
+        if (len > 0)
+            len--;
+    }
+
+    return lcp;
+}
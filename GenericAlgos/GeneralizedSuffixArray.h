@@ -0,0 +1,165 @@
+#pragma once
+
+#include <string_view>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "PackedIndexVector.h"
+#include "TopK.h"
+#include "WaveletTree.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Occurrence of a pattern inside of a document
+    struct DocumentPosition
+    {
+        IndexType document;
+        IndexType offset;
+
+        bool operator == (const DocumentPosition& other) const { return document == other.document && offset == other.offset; }
+    };
+
+    // Number of occurrences of a pattern in a document
+    struct DocumentFrequency
+    {
+        IndexType document;
+        IndexType frequency;
+
+        bool operator == (const DocumentFrequency& other) const { return document == other.document && frequency == other.frequency; }
+    };
+
+    // Substring shared by several documents: its length and its first occurrence in every document containing it,
+    // in increasing order of document ids
+    struct CommonSubstring
+    {
+        IndexType length;
+        GenericVector<DocumentPosition> occurrences;
+    };
+
+    // Orders documents by frequency, for equal frequencies smaller document ids come first
+    struct DocumentFrequencyComparer
+    {
+        bool operator()(const DocumentFrequency& a, const DocumentFrequency& b) const
+        {
+            return (a.frequency != b.frequency) ? (a.frequency < b.frequency) : (a.document > b.document);
+        }
+    };
+
+    // Suffix array over a collection of documents
+    // Documents are concatenated with unique separators, smaller than all characters and ordered by document id,
+    // so no suffix order and no match crosses a document boundary. Construction is linear by induced sorting
+    // over the integer alphabet of separators and characters.
+    class GeneralizedSuffixArray
+    {
+    public:
+
+        // Build suffix array over given documents, document ids are their indexes
+        // Throws std::length_error if there are too many documents for 32-bit symbols
+        explicit GeneralizedSuffixArray(const GenericVector<std::string_view>& documents);
+
+        explicit GeneralizedSuffixArray(const GenericVector<std::string>& documents)
+            : GeneralizedSuffixArray(GenericVector<std::string_view>(documents.begin(), documents.end()))
+        {
+        }
+
+        // Merge suffix arrays of two collections into the suffix array of their concatenation without re-sorting
+        // Documents of newer get ids following the documents of older. Takes O(n * H0) time: every suffix of newer is
+        // ranked among suffixes of older by backward search over the Burrows-Wheeler transform of older.
+        static GeneralizedSuffixArray merge(const GeneralizedSuffixArray& older, const GeneralizedSuffixArray& newer);
+
+        // Number of documents
+        IndexType documentCount() const { return m_docStarts.size(); }
+
+        // Text of given document
+        std::string_view document(IndexType doc) const
+        {
+            const IndexType start = m_docStarts.at(doc);
+            return std::string_view(m_text).substr(start, docEnd(doc) - start);
+        }
+
+        // Number of suffixes, equal to the total length of the documents
+        IndexType size() const { return m_suffixArray.size(); }
+
+        // Document and offset of the suffix of given order
+        DocumentPosition getPosition(IndexType order) const
+        {
+            return toDocumentPosition(m_suffixArray[order]);
+        }
+
+        // Document and offset of given position in the concatenated text of the documents and separators
+        DocumentPosition toDocumentPosition(IndexType pos) const
+        {
+            const IndexType doc = m_separators.rank1(pos);
+            return { doc, pos - m_docStarts[doc] };
+        }
+
+        // Range [lo, hi) of orders of suffixes starting with pattern, empty range positioned where pattern would be
+        std::pair<IndexType, IndexType> findRange(std::string_view pattern) const;
+
+        // Number of occurrences of pattern in all documents
+        IndexType count(std::string_view pattern) const
+        {
+            const auto range = findRange(pattern);
+            return range.second - range.first;
+        }
+
+        // All occurrences of pattern in lexicographic order of the suffixes
+        GenericVector<DocumentPosition> occurrences(std::string_view pattern) const;
+
+        // Ids of documents containing pattern in increasing order
+        IndexVct documentsContaining(std::string_view pattern) const;
+
+        // Numbers of occurrences of pattern in documents containing it, in increasing order of document ids
+        GenericVector<DocumentFrequency> documentFrequencies(std::string_view pattern) const;
+
+        // At most K documents with most occurrences of pattern, from the most frequent one
+        template <IndexType K> GenericVector<DocumentFrequency> topDocuments(std::string_view pattern) const
+        {
+            const GenericVector<DocumentFrequency> frequencies = documentFrequencies(pattern);
+
+            TopK<DocumentFrequency, K, DocumentFrequencyComparer> top;
+            top.push(frequencies.begin(), frequencies.end());
+            return top.extractSorted();
+        }
+
+        // Longest substring occurring in at least minDocuments documents, the lexicographically smallest if there are several
+        // O(n) by a sliding window over suffixes covering minDocuments documents and the LCP array built by Kasai's algorithm.
+        // Length is 0 if no symbol is shared.
+        // Throws std::invalid_argument if minDocuments is smaller than 2 or bigger than the number of documents
+        CommonSubstring longestCommonSubstring(IndexType minDocuments) const;
+
+        // Size of the text and index structures in bytes
+        IndexType memoryUsage() const
+        {
+            return m_text.size() + m_separators.memoryUsage() + m_docStarts.memoryUsage() + m_suffixArray.memoryUsage();
+        }
+
+    private:
+
+        GeneralizedSuffixArray() = default; // Used by merge()
+
+        std::string m_text; // Documents each followed by a separator byte
+
+        RankBitVector m_separators; // Separator positions in m_text, their rank is the document of a position
+
+        PackedIndexVct m_docStarts; // Start of every document in m_text
+
+        PackedIndexVct m_suffixArray; // Positions of suffixes of documents in m_text, separator suffixes excluded
+
+        // End of document (position of its separator)
+        IndexType docEnd(IndexType doc) const
+        {
+            return (doc + 1 < m_docStarts.size()) ? m_docStarts[doc + 1] - 1 : m_text.size() - 1;
+        }
+
+        // Finds the first order of suffix whose prefix of pattern length is not smaller than pattern,
+        // or with upper set the first order of suffix whose prefix is bigger than pattern
+        IndexType findBound(std::string_view pattern, bool upper, IndexType left) const;
+
+        // LCP array of the suffix array, common prefixes end at separators
+        // Document of the suffix of every order is stored in documents
+        IndexVct buildLcpArray(GenericVector<uint32_t>& documents) const;
+
+    }; // End of class GeneralizedSuffixArray
+
+}
@@ -31,6 +31,14 @@ namespace GeneralAlgorithmsAndDataStructures
 			return top;
 		}
 
+		// Replace the front element with given value and update the heap with a single bubble down
+		// Cheaper than extractTop() followed by an insert
+		void replaceTop(T val)
+		{
+			m_heapData[TopIdx] = std::move(val);
+			bubbleDown(TopIdx);
+		}
+
 		// Delete item with given value, return true if succeeded
 		// size() is virtual and may not refer to the end of the array
 		bool deleteItem(const T& val)
@@ -54,6 +62,9 @@ namespace GeneralAlgorithmsAndDataStructures
 		// Must be called by a derived class usually in constructor once the storage was filled 
 		void heapify()
 		{
+			if (size() < 2) // Already a heap
+				return;
+
 			// Bubble down starting with n-1 row , complexity m*lg n - lg m!  => O(n)
 			// Do not decrease potentially unsigned parentIdx below zero (TopIdx may be zero)
 			for (auto parentIdx = getParentIdx(getLastIndex()); parentIdx > TopIdx; parentIdx--)
@@ -125,7 +136,8 @@ namespace GeneralAlgorithmsAndDataStructures
 				if (compare(m_heapData[topChildIdx], m_heapData[itemIdx])) // If swap is needed
 				{
 					std::swap(m_heapData[itemIdx], m_heapData[topChildIdx]);
-					topChildIdx = getLeftChildIdx(topChildIdx);
+					itemIdx = topChildIdx; // Follow the item to its new position
+					topChildIdx = getLeftChildIdx(itemIdx);
 				}
 				else
 					orderSet = true; // No need to run further iterations
@@ -144,7 +156,12 @@ namespace GeneralAlgorithmsAndDataStructures
 			{
 				m_heapData[targetIdx] = std::move(m_heapData[getLastIndex()]);
 				dropLastElem();
-				bubbleDown(targetIdx);
+
+				// Moved item may belong either above or below the removed one
+				if (targetIdx > TopIdx && Comparer()(m_heapData[targetIdx], m_heapData[getParentIdx(targetIdx)]))
+					bubbleUp(targetIdx);
+				else
+					bubbleDown(targetIdx);
 			}
 			else if (targetIdx == getLastIndex())
 				dropLastElem();
@@ -190,6 +207,22 @@ namespace GeneralAlgorithmsAndDataStructures
 		// Build Heap from rvalue initializer list (with moving)
 		Heap(std::initializer_list<T>&& heapData) : HeapBase<T, Comparer>(m_heapDataStorage), m_heapDataStorage(std::move(heapData)) { HeapBase<T, Comparer>::heapify(); }
 
+		// Copy and move rebind the base to own storage
+		Heap(const Heap& other) : HeapBase<T, Comparer>(m_heapDataStorage), m_heapDataStorage(other.m_heapDataStorage) {}
+		Heap(Heap&& other) noexcept : HeapBase<T, Comparer>(m_heapDataStorage), m_heapDataStorage(std::move(other.m_heapDataStorage)) {}
+
+		Heap& operator = (const Heap& other)
+		{
+			m_heapDataStorage = other.m_heapDataStorage;
+			return *this;
+		}
+
+		Heap& operator = (Heap&& other) noexcept
+		{
+			m_heapDataStorage = std::move(other.m_heapDataStorage);
+			return *this;
+		}
+
 		// Add new element (possibly building it from its constructor parameters through emplace_back())
 		// and update Heap, variadic function template using universal reference to pass constructor params
 		template<typename... Args> void insert(Args&&... item)
@@ -215,21 +248,25 @@ namespace GeneralAlgorithmsAndDataStructures
 	// Max Heap
 	template <typename T> using MaxHeap = Heap< T, std::greater<T> >;
 
-	// Inplace heapsort helper 
-	template <typename T> class HeapSorter : private HeapBase< T, std::greater<T> >
+	// Inplace heapsort helper
+	// Elements are put in reverse Comparer order, ascending order for default std::greater
+	template <typename T, typename Comparer = std::greater<T> > class HeapSorter : private HeapBase<T, Comparer>
 	{
 	public:
 		// Build Heap using provided vector with data to sort
-		HeapSorter(GenericVector<T>& heapData) : HeapBase< T, std::greater<T> >(heapData), m_nbOfElementsInHeap(heapData.size()) {}
+		HeapSorter(GenericVector<T>& heapData) : HeapBase<T, Comparer>(heapData), m_nbOfElementsInHeap(heapData.size()) {}
 
 		void sort()
 		{
-			HeapBase< T, std::greater<T> >::heapify();
+			if (m_nbOfElementsInHeap < 2) // Nothing to sort
+				return;
+
+			HeapBase<T, Comparer>::heapify();
 			
 			while (m_nbOfElementsInHeap > 1)
 			{
-				T biggest = HeapBase< T, std::greater<T> >::extractTop(); // Extract the biggest element, calls dropLastElem()
-				HeapBase< T, std::greater<T> >::m_heapData[m_nbOfElementsInHeap] = std::move(biggest); // Put it outside of current heap range
+				T biggest = HeapBase<T, Comparer>::extractTop(); // Extract the biggest element, calls dropLastElem()
+				HeapBase<T, Comparer>::m_heapData[m_nbOfElementsInHeap] = std::move(biggest); // Put it outside of current heap range
 			}
 		}
 
@@ -0,0 +1,110 @@
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+#ifdef _WIN32
+
+GADS::MappedFile::MappedFile(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open file " + path);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read size of file " + path);
+    }
+    m_size = static_cast<IndexType>(fileSize.QuadPart);
+
+    if (m_size > 0) // Empty files cannot be mapped
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+
+    if (m_size > 0 && m_data == nullptr)
+        throw std::runtime_error("Cannot map file " + path);
+}
+
+void GADS::MappedFile::unmap()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+}
+
+#else
+
+GADS::MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open file " + path);
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Cannot read size of file " + path);
+    }
+    m_size = static_cast<IndexType>(fileStat.st_size);
+
+    if (m_size > 0) // Empty files cannot be mapped
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data != MAP_FAILED)
+            m_data = data;
+    }
+    close(fd); // The mapping stays valid after closing the descriptor
+
+    if (m_size > 0 && m_data == nullptr)
+        throw std::runtime_error("Cannot map file " + path);
+}
+
+void GADS::MappedFile::unmap()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<void*>(m_data), m_size);
+}
+
+#endif
+
+GADS::MappedFile::MappedFile(MappedFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+GADS::MappedFile& GADS::MappedFile::operator = (MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+GADS::MappedFile::~MappedFile()
+{
+    unmap();
+}
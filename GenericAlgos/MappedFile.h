@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Read-only memory mapping of a whole file
+    // Pages are shared through the page cache by all processes mapping the same file
+    class MappedFile
+    {
+    public:
+
+        // Map given file
+        // Throws std::runtime_error if the file cannot be opened or mapped
+        explicit MappedFile(const std::string& path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator = (MappedFile&& other) noexcept;
+
+        ~MappedFile();
+
+        const void* data() const { return m_data; }
+
+        IndexType size() const { return m_size; }
+
+    private:
+
+        const void* m_data = nullptr;
+        IndexType m_size = 0;
+
+        void unmap();
+
+    }; // End of class MappedFile
+
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Width of stored indexes
+    enum class IndexWidth
+    {
+        Auto, // Smallest width able to store the largest index
+        Bits32,
+        Bits40,
+        Bits64
+    };
+
+    // Vector of indexes packed into 4, 5 or 8 bytes per entry
+    // Entries are either owned or viewed in external read-only memory (e.g. a mapped file)
+    class PackedIndexVct
+    {
+    public:
+
+        using value_type = IndexType;
+        using const_reference = IndexType;
+
+        // Create empty vector
+        PackedIndexVct() = default;
+
+        // Create vector of given size filled with 0, entries use widthBytes bytes (4, 5 or 8)
+        PackedIndexVct(IndexType size, IndexType widthBytes) : m_size(size), m_width(widthBytes), m_bytes(size * widthBytes)
+        {
+            assert(widthBytes == 4 || widthBytes == 5 || widthBytes == 8);
+        }
+
+        // Create vector from given indexes
+        template <typename Array> PackedIndexVct(const Array& values, IndexType widthBytes) : PackedIndexVct(values.size(), widthBytes)
+        {
+            for (IndexType i = 0; i < m_size; i++)
+                set(i, values[i]);
+        }
+
+        // Create read-only view of size entries of widthBytes bytes stored at given address
+        // The memory has to outlive the view and all its copies
+        static PackedIndexVct view(const void* bytes, IndexType size, IndexType widthBytes)
+        {
+            assert(widthBytes == 4 || widthBytes == 5 || widthBytes == 8);
+
+            PackedIndexVct result;
+            result.m_size = size;
+            result.m_width = widthBytes;
+            result.m_view = static_cast<const uint8_t*>(bytes);
+            return result;
+        }
+
+        // Number of bytes needed to store indexes up to maxValue for requested width
+        // Throws std::invalid_argument if requested width is too small
+        static IndexType widthBytes(IndexType maxValue, IndexWidth width = IndexWidth::Auto)
+        {
+            constexpr uint64_t Max32 = 0xFFFFFFFFull;
+            constexpr uint64_t Max40 = 0xFFFFFFFFFFull;
+
+            switch (width)
+            {
+            case IndexWidth::Bits32:
+                if (maxValue > Max32)
+                    throw std::invalid_argument("Index does not fit 32 bits");
+                return 4;
+            case IndexWidth::Bits40:
+                if (maxValue > Max40)
+                    throw std::invalid_argument("Index does not fit 40 bits");
+                return 5;
+            case IndexWidth::Bits64:
+                return 8;
+            default:
+                return (maxValue <= Max32) ? 4 : (maxValue <= Max40) ? 5 : 8;
+            }
+        }
+
+        IndexType size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        // Bytes per entry
+        IndexType width() const { return m_width; }
+
+        // Checks if entries are stored in external memory
+        bool isView() const { return m_view != nullptr; }
+
+        // Packed entries, size() * width() bytes
+        const uint8_t* data() const { return m_view ? m_view : m_bytes.data(); }
+
+        IndexType operator[](IndexType i) const
+        {
+            const uint8_t* entry = data() + i * m_width;
+
+            if (m_width == 4)
+            {
+                uint32_t val;
+                std::memcpy(&val, entry, sizeof(val));
+                return val;
+            }
+            else if (m_width == 8)
+            {
+                uint64_t val;
+                std::memcpy(&val, entry, sizeof(val));
+                return static_cast<IndexType>(val);
+            }
+            else
+            {
+                uint32_t low;
+                std::memcpy(&low, entry, sizeof(low));
+                return static_cast<IndexType>(low | (static_cast<uint64_t>(entry[4]) << 32));
+            }
+        }
+
+        // Throws std::out_of_range if i is not valid
+        IndexType at(IndexType i) const
+        {
+            if (i >= m_size)
+                throw std::out_of_range("Index out of range");
+            return (*this)[i];
+        }
+
+        void set(IndexType i, IndexType val)
+        {
+            assert(!isView());
+
+            uint8_t* entry = m_bytes.data() + i * m_width;
+
+            if (m_width == 4)
+            {
+                const uint32_t packed = static_cast<uint32_t>(val);
+                std::memcpy(entry, &packed, sizeof(packed));
+            }
+            else if (m_width == 8)
+            {
+                const uint64_t packed = val;
+                std::memcpy(entry, &packed, sizeof(packed));
+            }
+            else
+            {
+                const uint32_t low = static_cast<uint32_t>(val);
+                std::memcpy(entry, &low, sizeof(low));
+                entry[4] = static_cast<uint8_t>(static_cast<uint64_t>(val) >> 32);
+            }
+        }
+
+        // Unpacked copy of the entries
+        IndexVct toVector() const
+        {
+            IndexVct result(m_size);
+            for (IndexType i = 0; i < m_size; i++)
+                result[i] = (*this)[i];
+            return result;
+        }
+
+        // Size of the entries in bytes
+        IndexType memoryUsage() const { return m_size * m_width; }
+
+    private:
+
+        IndexType m_size = 0;
+        IndexType m_width = 8;
+
+        GenericVector<uint8_t> m_bytes; // Owned entries
+        const uint8_t* m_view = nullptr; // External entries
+
+    }; // End of class PackedIndexVct
+
+}
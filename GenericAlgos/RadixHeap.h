@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <stdexcept>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+	// Monotone min priority queue for unsigned integer keys (radix heap)
+	// Inserted keys must not be smaller than the last extracted key (Dijkstra, event simulation etc.)
+	// Entries are kept in buckets selected by the highest bit differing from the last extracted key
+	// and may only move towards lower buckets, giving amortized O(log C) insert/extractTop
+	// Key - unsigned integer key type, T - payload stored with the key
+	template <typename Key, typename T> class RadixHeap
+	{
+		static_assert(std::is_unsigned<Key>::value, "RadixHeap requires unsigned integer keys");
+
+	public:
+
+		using Entry = std::pair<Key, T>;
+
+		// Create empty RadixHeap
+		RadixHeap() : m_buckets(BucketCount) {}
+
+		// Return number of elements in the heap
+		IndexType size() const { return m_size; }
+
+		bool empty() const { return m_size == 0; }
+
+		// Last extracted key, lower limit for inserted keys
+		Key lastKey() const { return m_lastKey; }
+
+		// Add new entry (possibly building the payload from its constructor parameters)
+		// Throws std::invalid_argument if the key is smaller than the last extracted one
+		template<typename... Args> void insert(Key key, Args&&... payload)
+		{
+			if (key < m_lastKey)
+				throw std::invalid_argument("Key smaller than the last extracted key");
+
+			m_buckets[getBucketIdx(key)].emplace_back(std::piecewise_construct,
+				std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(payload)...));
+			m_size++;
+		}
+
+		// Return the entry with the smallest key
+		// Throws std::out_of_range if the heap is empty
+		const Entry& top()
+		{
+			pullMinToFront();
+			return m_buckets[TopBucketIdx].back();
+		}
+
+		// Remove and return the entry with the smallest key
+		// Throws std::out_of_range if the heap is empty
+		Entry extractTop()
+		{
+			pullMinToFront();
+
+			Entry top = std::move(m_buckets[TopBucketIdx].back());
+			m_buckets[TopBucketIdx].pop_back();
+			m_size--;
+			return top;
+		}
+
+		// Remove all entries, bucket capacity is kept for reuse
+		void clear()
+		{
+			for (auto& bucket : m_buckets)
+				bucket.clear();
+			m_size = 0;
+			m_lastKey = 0;
+		}
+
+	private:
+
+		using Bucket = GenericVector<Entry>;
+
+		// Bucket 0 holds keys equal to the last extracted key, bucket k keys differing on bit k-1 at most
+		constexpr static IndexType BucketCount = std::numeric_limits<Key>::digits + 1;
+		constexpr static IndexType TopBucketIdx = 0;
+
+		GenericVector<Bucket> m_buckets;
+
+		IndexType m_size = 0;
+
+		Key m_lastKey = 0;
+
+		// Number of significant bits of the value
+		static IndexType bitWidth(Key val)
+		{
+			if (val == 0)
+				return 0;
+#if defined(__GNUC__) || defined(__clang__)
+			return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(val);
+#else
+			IndexType width = 0;
+			for (; val != 0; val >>= 1)
+				width++;
+			return width;
+#endif
+		}
+
+		IndexType getBucketIdx(Key key) const { return bitWidth(key ^ m_lastKey); }
+
+		// Makes sure the top bucket is not empty by redistributing the first non empty bucket
+		// around its smallest key, entries are moved in bulk towards lower buckets
+		void pullMinToFront()
+		{
+			if (m_size == 0)
+				throw std::out_of_range("Heap is empty");
+
+			if (!m_buckets[TopBucketIdx].empty())
+				return;
+
+			IndexType bucketIdx = TopBucketIdx + 1;
+			while (m_buckets[bucketIdx].empty())
+				bucketIdx++;
+
+			Bucket& bucket = m_buckets[bucketIdx];
+
+			m_lastKey = std::min_element(bucket.cbegin(), bucket.cend(),
+				[](const Entry& a, const Entry& b) { return a.first < b.first; })->first;
+
+			// All entries of the bucket share bits above bucketIdx - 1 with the new last key, hence land below bucketIdx
+			for (auto& entry : bucket)
+				m_buckets[getBucketIdx(entry.first)].emplace_back(std::move(entry));
+
+			bucket.clear();
+		}
+
+	}; // End of class RadixHeap
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <limits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "PackedIndexVector.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Kinds of range minimum query structures
+    enum class RmqKind
+    {
+        SparseTable, // O(1) query, n log n entries
+        BlockSparseTable // Sparse table over minima of blocks of BlockSize entries, O(BlockSize) query, about 2n / BlockSize log n entries
+    };
+
+    // Range minimum query structure over an array of indexes
+    // The array itself is not stored and has to be passed to every query, allowing its owner to be copied or moved
+    class RangeMinimumQuery
+    {
+    public:
+
+        constexpr static IndexType BlockSize = 32;
+
+        // Create empty structure
+        RangeMinimumQuery() = default;
+
+        // Build structure for given array, Array - any container with operator[] and size()
+        // Minima are stored using widthBytes bytes per entry (see PackedIndexVct)
+        template <typename Array> RangeMinimumQuery(const Array& data, RmqKind kind, IndexType widthBytes = sizeof(uint64_t))
+            : m_kind(kind), m_width(widthBytes)
+        {
+            if (kind == RmqKind::BlockSparseTable)
+            {
+                m_blockMinimum = PackedIndexVct((data.size() + BlockSize - 1) / BlockSize, m_width);
+                for (IndexType b = 0; b < m_blockMinimum.size(); b++)
+                    m_blockMinimum.set(b, scanMinimum(data, b * BlockSize, std::min<IndexType>(data.size(), (b + 1) * BlockSize) - 1));
+
+                buildLevels(m_blockMinimum);
+            }
+            else
+                buildLevels(data);
+        }
+
+        // Adopt prebuilt tables (e.g. viewed in a mapped file) as returned by blockMinimum() and levels()
+        RangeMinimumQuery(RmqKind kind, IndexType widthBytes, PackedIndexVct blockMinimum, GenericVector<PackedIndexVct> levels)
+            : m_kind(kind), m_width(widthBytes), m_blockMinimum(std::move(blockMinimum)), m_levels(std::move(levels))
+        {
+        }
+
+        RmqKind kind() const { return m_kind; }
+
+        // Minima of blocks, empty for RmqKind::SparseTable
+        const PackedIndexVct& blockMinimum() const { return m_blockMinimum; }
+
+        // Sparse table levels
+        const GenericVector<PackedIndexVct>& levels() const { return m_levels; }
+
+        // Return the smallest value of data in range [beg, end]
+        template <typename Array> IndexType minimum(const Array& data, IndexType beg, IndexType end) const
+        {
+            assert(beg <= end && end < data.size());
+
+            if (m_kind == RmqKind::SparseTable)
+                return sparseMinimum(data, beg, end);
+
+            const IndexType begBlock = beg / BlockSize;
+            const IndexType endBlock = end / BlockSize;
+
+            if (begBlock == endBlock)
+                return scanMinimum(data, beg, end);
+
+            // Partial border blocks are scanned, full blocks in between are looked up
+            IndexType result = std::min(scanMinimum(data, beg, (begBlock + 1) * BlockSize - 1), scanMinimum(data, endBlock * BlockSize, end));
+            if (begBlock + 1 < endBlock)
+                result = std::min(result, sparseMinimum(m_blockMinimum, begBlock + 1, endBlock - 1));
+
+            return result;
+        }
+
+        // Size of the structure in bytes
+        IndexType memoryUsage() const
+        {
+            IndexType bytes = m_blockMinimum.memoryUsage();
+            for (const auto& level : m_levels)
+                bytes += level.memoryUsage();
+            return bytes;
+        }
+
+    private:
+
+        RmqKind m_kind = RmqKind::SparseTable;
+        IndexType m_width = sizeof(uint64_t);
+
+        PackedIndexVct m_blockMinimum; // Minimum of every block for RmqKind::BlockSparseTable
+
+        // Level k - 1 stores minima of ranges of 2^k entries of the base array (data or block minima)
+        GenericVector<PackedIndexVct> m_levels;
+
+        static IndexType floorLog2(IndexType val)
+        {
+            assert(val > 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(val);
+#else
+            IndexType result = 0;
+            while (val >>= 1)
+                result++;
+            return result;
+#endif
+        }
+
+        template <typename Array> static IndexType scanMinimum(const Array& data, IndexType beg, IndexType end)
+        {
+            IndexType result = data[beg];
+            for (IndexType i = beg + 1; i <= end; i++)
+                result = std::min<IndexType>(result, data[i]);
+            return result;
+        }
+
+        template <typename Array> void buildLevels(const Array& base)
+        {
+            for (IndexType k = 1; (IndexType(1) << k) <= base.size(); k++)
+            {
+                const IndexType half = IndexType(1) << (k - 1);
+                PackedIndexVct level(base.size() - (half << 1) + 1, m_width);
+
+                for (IndexType i = 0; i < level.size(); i++)
+                {
+                    if (k == 1)
+                        level.set(i, std::min<IndexType>(base[i], base[i + half]));
+                    else
+                        level.set(i, std::min(m_levels.back()[i], m_levels.back()[i + half]));
+                }
+
+                m_levels.emplace_back(std::move(level));
+            }
+        }
+
+        template <typename Array> IndexType sparseMinimum(const Array& base, IndexType beg, IndexType end) const
+        {
+            const IndexType k = floorLog2(end - beg + 1);
+            if (k == 0)
+                return base[beg];
+
+            const PackedIndexVct& level = m_levels[k - 1];
+            return std::min(level[beg], level[end + 1 - (IndexType(1) << k)]);
+        }
+
+    }; // End of class RangeMinimumQuery
+
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "SegmentedSuffixArray.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+GADS::SegmentedSuffixArray::SegmentedSuffixArray(ThreadPool* pool, IndexType mergeFactor)
+    : m_pool(pool), m_mergeFactor(mergeFactor)
+{
+}
+
+GADS::SegmentedSuffixArray::~SegmentedSuffixArray()
+{
+    waitForMerges();
+}
+
+// Only the new segment is sorted, merging is left to a single merge loop at a time
+GADS::IndexType GADS::SegmentedSuffixArray::append(std::string_view batch)
+{
+    auto index = std::make_shared<const GeneralizedSuffixArray>(GenericVector<std::string_view>{ batch });
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const IndexType id = m_batchCount++;
+    m_size += batch.size();
+    m_segments.push_back({ std::move(index), id });
+
+    if (m_merging || mergeCandidate() == m_segments.size())
+        return id;
+
+    m_merging = true;
+    lock.unlock();
+    if (m_pool)
+        m_pool->submit([this]() { mergeSegments(); });
+    else
+        mergeSegments();
+    return id;
+}
+
+void GADS::SegmentedSuffixArray::waitForMerges()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_mergeDone.wait(lock, [this]() { return !m_merging; });
+}
+
+GADS::IndexType GADS::SegmentedSuffixArray::batchCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_batchCount;
+}
+
+GADS::IndexType GADS::SegmentedSuffixArray::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+GADS::IndexType GADS::SegmentedSuffixArray::segmentCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_segments.size();
+}
+
+std::string GADS::SegmentedSuffixArray::batch(IndexType batch) const
+{
+    const GenericVector<Segment> segments = snapshot();
+    if (segments.empty() || batch >= segments.back().firstBatch + segments.back().index->documentCount())
+        throw std::out_of_range("Batch out of range");
+
+    const auto segment = std::upper_bound(segments.begin(), segments.end(), batch,
+        [](IndexType id, const Segment& s) { return id < s.firstBatch; }) - 1;
+    return std::string(segment->index->document(batch - segment->firstBatch));
+}
+
+GADS::IndexType GADS::SegmentedSuffixArray::count(std::string_view pattern) const
+{
+    IndexType result = 0;
+    for (const auto& segment : snapshot())
+        result += segment.index->count(pattern);
+    return result;
+}
+
+// Segments hold increasing ranges of batches, so sorting every segment's occurrences sorts all of them
+GADS::GenericVector<GADS::DocumentPosition> GADS::SegmentedSuffixArray::occurrences(std::string_view pattern) const
+{
+    GenericVector<DocumentPosition> result;
+    for (const auto& segment : snapshot())
+    {
+        const IndexType first = result.size();
+        for (const auto& occurrence : segment.index->occurrences(pattern))
+            result.push_back({ occurrence.document + segment.firstBatch, occurrence.offset });
+
+        std::sort(result.begin() + first, result.end(), [](const DocumentPosition& a, const DocumentPosition& b)
+            {
+                return (a.document != b.document) ? (a.document < b.document) : (a.offset < b.offset);
+            });
+    }
+    return result;
+}
+
+GADS::IndexType GADS::SegmentedSuffixArray::memoryUsage() const
+{
+    IndexType result = 0;
+    for (const auto& segment : snapshot())
+        result += segment.index->memoryUsage();
+    return result;
+}
+
+GADS::GenericVector<GADS::SegmentedSuffixArray::Segment> GADS::SegmentedSuffixArray::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_segments;
+}
+
+// Of the adjacent pairs whose older segment is not mergeFactor times bigger, the smallest is merged first,
+// so segments piled up during a long merge are combined pairwise instead of one by one into a growing segment
+// Once no candidate remains, sizes from the oldest segment decrease by mergeFactor at least
+GADS::IndexType GADS::SegmentedSuffixArray::mergeCandidate() const
+{
+    auto segmentSize = [this](IndexType i) { return m_segments[i].index->size() + m_segments[i].index->documentCount(); };
+
+    IndexType candidate = m_segments.size();
+    IndexType candidateSize = 0;
+    for (IndexType i = 1; i < m_segments.size(); i++)
+    {
+        const IndexType older = segmentSize(i - 1);
+        const IndexType newer = segmentSize(i);
+        if (older < m_mergeFactor * newer && (candidate == m_segments.size() || older + newer < candidateSize))
+        {
+            candidate = i - 1;
+            candidateSize = older + newer;
+        }
+    }
+    return candidate;
+}
+
+// Segments before the newest are changed by this loop only, so the merged pair stays at its index
+void GADS::SegmentedSuffixArray::mergeSegments()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    try
+    {
+        for (IndexType i = mergeCandidate(); i < m_segments.size(); i = mergeCandidate())
+        {
+            const auto older = m_segments[i].index;
+            const auto newer = m_segments[i + 1].index;
+
+            lock.unlock();
+            auto merged = std::make_shared<const GeneralizedSuffixArray>(GeneralizedSuffixArray::merge(*older, *newer));
+            lock.lock();
+
+            m_segments[i].index = std::move(merged);
+            m_segments.erase(m_segments.begin() + i + 1);
+        }
+    }
+    catch (...)
+    {
+        // Segments stay unmerged but valid
+        if (!lock.owns_lock())
+            lock.lock();
+        m_merging = false;
+        m_mergeDone.notify_all();
+        throw;
+    }
+
+    m_merging = false;
+    m_mergeDone.notify_all();
+}
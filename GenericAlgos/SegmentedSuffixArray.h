@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "GeneralizedSuffixArray.h"
+#include "ThreadPool.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Growing text index built from appended batches of text, organized like a log-structured merge tree
+    // Every append indexes only the new batch as a small segment. Adjacent segments of similar sizes are merged
+    // by GeneralizedSuffixArray::merge, in the background if a thread pool is given, so every position takes
+    // part in O(log n) merges. Queries fan out over the segments present at the time of the call.
+    // Batches are separate documents: no match crosses a batch boundary.
+    class SegmentedSuffixArray
+    {
+    public:
+
+        // Segments are merged while the older one is smaller than mergeFactor times the newer one, 0 disables merging
+        // Merges run as tasks of pool if given, otherwise inside append(). The pool must outlive the index.
+        explicit SegmentedSuffixArray(ThreadPool* pool = nullptr, IndexType mergeFactor = 2);
+
+        SegmentedSuffixArray(const SegmentedSuffixArray&) = delete;
+        SegmentedSuffixArray& operator = (const SegmentedSuffixArray&) = delete;
+
+        // Waits for a running merge
+        ~SegmentedSuffixArray();
+
+        // Index batch as a new segment, returns its batch id
+        IndexType append(std::string_view batch);
+
+        // Blocks until no merge is running
+        void waitForMerges();
+
+        // Number of appended batches
+        IndexType batchCount() const;
+
+        // Total length of the appended batches
+        IndexType size() const;
+
+        // Number of segments at the moment
+        IndexType segmentCount() const;
+
+        // Text of given batch
+        // Throws std::out_of_range if batch is not valid
+        std::string batch(IndexType batch) const;
+
+        // Number of occurrences of pattern in all batches
+        IndexType count(std::string_view pattern) const;
+
+        // All occurrences of pattern as batch ids and offsets, sorted by batch and offset
+        GenericVector<DocumentPosition> occurrences(std::string_view pattern) const;
+
+        // Size of the text and index structures of all segments in bytes
+        IndexType memoryUsage() const;
+
+    private:
+
+        // Suffix array over consecutive batches, its documents are batches from firstBatch on
+        struct Segment
+        {
+            std::shared_ptr<const GeneralizedSuffixArray> index;
+            IndexType firstBatch;
+        };
+
+        ThreadPool* m_pool;
+        IndexType m_mergeFactor;
+
+        mutable std::mutex m_mutex; // Guards all members below
+        GenericVector<Segment> m_segments; // From the oldest batches
+        IndexType m_batchCount = 0;
+        IndexType m_size = 0;
+        bool m_merging = false;
+        std::condition_variable m_mergeDone;
+
+        // Copy of the segment list, queries run on it without holding the lock
+        GenericVector<Segment> snapshot() const;
+
+        // Index of the segment to merge with its successor, or segment count if none, requires the lock
+        IndexType mergeCandidate() const;
+
+        // Merges segments until no candidate remains, the lock is released while merging
+        void mergeSegments();
+
+    }; // End of class SegmentedSuffixArray
+
+}
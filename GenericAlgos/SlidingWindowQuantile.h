@@ -0,0 +1,234 @@
+#pragma once
+
+#include <deque>
+#include <stdexcept>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+	// Tracks q-quantile of a sliding window of values in O(log w) per update
+	// Window elements are split between MaxHeap of the lower part (with the quantile on top) and MinHeap of the upper part
+	// Evicted elements are deleted lazily when they reach the top of a heap, heaps are compacted when stale elements prevail
+	// Quantile of w elements is the element of 0-based rank floor(q * (w - 1)), the lower median for q = 0.5
+	// The quantile is fixed per tracker, several trackers can be used to follow several quantiles
+	template <typename T> class SlidingWindowQuantile
+	{
+	public:
+
+		// Create empty window tracking given quantile
+		// Throws std::invalid_argument if q is outside of [0, 1]
+		SlidingWindowQuantile(double q) : m_q(q)
+		{
+			if (!(q >= 0.0 && q <= 1.0))
+				throw std::invalid_argument("Quantile outside of range [0, 1]");
+		}
+
+		// Return number of elements in the window
+		IndexType size() const { return m_window.size(); }
+
+		// Add new element to the window
+		void push(const T& val)
+		{
+			insert(val);
+			rebalance();
+		}
+
+		// Add range of elements to the window, heaps are rebalanced once for entire batch
+		template <typename Iterator> void push(Iterator beg, Iterator end)
+		{
+			for (; beg != end; ++beg)
+				insert(*beg);
+			rebalance();
+		}
+
+		// Remove given number of the oldest elements from the window
+		// Throws std::out_of_range if the window contains less elements
+		void evictOldest(IndexType count = 1)
+		{
+			if (count > size())
+				throw std::out_of_range("Window contains less elements");
+
+			for (IndexType i = 0; i < count; i++)
+				remove();
+
+			rebalance();
+			compact();
+		}
+
+		// Return the tracked quantile of the window
+		// Throws std::out_of_range if the window is empty
+		const T& quantile()
+		{
+			if (size() == 0)
+				throw std::out_of_range("Window is empty");
+
+			pruneTop(m_lower);
+			return m_lower.top().first;
+		}
+
+	private:
+
+		// Element with its sequence number making all heap entries unique
+		using Entry = std::pair<T, IndexType>;
+
+		// Heaps are rebuilt when they contain more stale entries than this and the window size
+		constexpr static IndexType CompactionSlack = 64;
+
+		double m_q;
+
+		std::deque<T> m_window; // Elements in arrival order
+
+		IndexType m_headSeq = 0; // Sequence number of the oldest element, entries below it are stale
+		IndexType m_tailSeq = 0; // Sequence number of the next element
+
+		MaxHeap<Entry> m_lower; // Elements up to the quantile
+		MinHeap<Entry> m_upper; // Elements after the quantile
+
+		IndexType m_lowerCount = 0; // Number of valid entries in m_lower
+		IndexType m_upperCount = 0; // Number of valid entries in m_upper
+
+		// Number of window elements belonging to the lower part
+		IndexType lowerTargetCount() const
+		{
+			if (size() == 0)
+				return 0;
+			return static_cast<IndexType>(m_q * (size() - 1)) + 1;
+		}
+
+		template <typename HeapType> void pruneTop(HeapType& heap)
+		{
+			while (heap.size() > 0 && heap.top().second < m_headSeq)
+				heap.extractTop();
+		}
+
+		void insert(const T& val)
+		{
+			Entry entry(val, m_tailSeq++);
+			m_window.push_back(val);
+
+			pruneTop(m_lower);
+			if (m_lowerCount == 0 || !(m_lower.top() < entry))
+			{
+				m_lower.insert(std::move(entry));
+				m_lowerCount++;
+			}
+			else
+			{
+				m_upper.insert(std::move(entry));
+				m_upperCount++;
+			}
+		}
+
+		void remove()
+		{
+			Entry entry(std::move(m_window.front()), m_headSeq);
+			m_window.pop_front();
+
+			// All valid lower entries precede all valid upper entries
+			pruneTop(m_lower);
+			if (m_lowerCount > 0 && !(m_lower.top() < entry))
+				m_lowerCount--;
+			else
+				m_upperCount--;
+
+			m_headSeq++; // Entry becomes stale
+		}
+
+		// Moves top entries between heaps until the lower part has its target size
+		void rebalance()
+		{
+			const IndexType target = lowerTargetCount();
+
+			while (m_lowerCount > target)
+			{
+				pruneTop(m_lower);
+				m_upper.insert(m_lower.extractTop());
+				m_lowerCount--;
+				m_upperCount++;
+			}
+
+			while (m_lowerCount < target)
+			{
+				pruneTop(m_upper);
+				m_lower.insert(m_upper.extractTop());
+				m_upperCount--;
+				m_lowerCount++;
+			}
+		}
+
+		// Drops stale entries from the heap once they outnumber the valid ones, amortized O(log w) per eviction
+		template <typename HeapType> void compact(HeapType& heap, IndexType validCount)
+		{
+			if (heap.size() <= 2 * validCount + CompactionSlack)
+				return;
+
+			GenericVector<Entry> entries;
+			entries.reserve(validCount);
+			while (heap.size() > 0)
+			{
+				Entry entry = heap.extractTop();
+				if (entry.second >= m_headSeq)
+					entries.emplace_back(std::move(entry));
+			}
+
+			heap = HeapType(std::move(entries));
+		}
+
+		void compact()
+		{
+			compact(m_lower, m_lowerCount);
+			compact(m_upper, m_upperCount);
+		}
+
+	}; // End of class SlidingWindowQuantile
+
+	// Sliding window median tracker
+	template <typename T> class SlidingWindowMedian : public SlidingWindowQuantile<T>
+	{
+	public:
+		SlidingWindowMedian() : SlidingWindowQuantile<T>(0.5) {}
+
+		// Return the lower median of the window
+		const T& median() { return SlidingWindowQuantile<T>::quantile(); }
+	};
+
+	// Batched sliding window mode: computes q-quantile of every window of given size in data,
+	// consecutive windows start step elements apart and the window is advanced by a batch of step elements
+	// Throws std::invalid_argument if window size or step are 0
+	template <typename T> GenericVector<T> slidingWindowQuantiles(const GenericVector<T>& data, IndexType windowSize, IndexType step, double q)
+	{
+		if (windowSize == 0 || step == 0)
+			throw std::invalid_argument("Window size and step must be positive");
+
+		GenericVector<T> result;
+		if (data.size() < windowSize)
+			return result;
+
+		result.reserve((data.size() - windowSize) / step + 1);
+
+		SlidingWindowQuantile<T> tracker(q);
+		tracker.push(data.cbegin(), data.cbegin() + windowSize);
+		result.push_back(tracker.quantile());
+
+		for (IndexType windowEnd = windowSize + step; windowEnd <= data.size(); windowEnd += step)
+		{
+			if (step < windowSize)
+			{
+				tracker.push(data.cbegin() + (windowEnd - step), data.cbegin() + windowEnd);
+				tracker.evictOldest(step);
+			}
+			else // Windows do not overlap
+			{
+				tracker.evictOldest(windowSize);
+				tracker.push(data.cbegin() + (windowEnd - windowSize), data.cbegin() + windowEnd);
+			}
+			result.push_back(tracker.quantile());
+		}
+
+		return result;
+	}
+
+}
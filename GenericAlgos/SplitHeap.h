@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+	// Type of the key extracted from T by functor KeyOf
+	template <typename T, typename KeyOf> using HeapKey = std::decay_t< std::invoke_result_t<KeyOf, const T&> >;
+
+	// Compares elements by their keys, KeyOf - functor extracting the key, Comparer - key comparer
+	template <typename T, typename KeyOf, typename Comparer> struct KeyComparer
+	{
+		bool operator()(const T& a, const T& b) const { return Comparer()(KeyOf()(a), KeyOf()(b)); }
+	};
+
+	// Entry sifted by SplitHeap: compact key and id of the slot storing the payload
+	template <typename Key> struct SplitHeapEntry
+	{
+		Key key;
+		uint32_t slot;
+	};
+
+	template <typename Key, typename Comparer> struct SplitHeapEntryComparer
+	{
+		bool operator()(const SplitHeapEntry<Key>& a, const SplitHeapEntry<Key>& b) const { return Comparer()(a.key, b.key); }
+	};
+
+	// Heap of large elements sifting only keys with 32-bit slot ids
+	// Elements are built in place in a slab of fixed size chunks and never move while in the heap,
+	// extractTop() moves the element out of the slab exactly once
+	// KeyOf - functor returning the key of an element, Comparer - key comparer like for Heap
+	template <typename T, typename KeyOf, typename Comparer = std::less< HeapKey<T, KeyOf> > >
+	class SplitHeap : private HeapBase< SplitHeapEntry< HeapKey<T, KeyOf> >, SplitHeapEntryComparer< HeapKey<T, KeyOf>, Comparer > >
+	{
+	public:
+
+		using Key = HeapKey<T, KeyOf>;
+
+	private:
+
+		using Entry = SplitHeapEntry<Key>;
+		using Base = HeapBase< Entry, SplitHeapEntryComparer<Key, Comparer> >;
+
+	public:
+
+		// Create empty heap
+		SplitHeap() : Base(m_entries) {}
+
+		SplitHeap(const SplitHeap&) = delete;
+		SplitHeap& operator = (const SplitHeap&) = delete;
+
+		SplitHeap(SplitHeap&& other) noexcept : Base(m_entries), m_entries(std::move(other.m_entries)),
+			m_chunks(std::move(other.m_chunks)), m_freeSlots(std::move(other.m_freeSlots)), m_slotCount(other.m_slotCount)
+		{
+			other.m_entries.clear();
+			other.m_slotCount = 0;
+		}
+
+		SplitHeap& operator = (SplitHeap&& other) noexcept
+		{
+			if (this != &other)
+			{
+				destroyElements();
+				m_entries = std::move(other.m_entries);
+				m_chunks = std::move(other.m_chunks);
+				m_freeSlots = std::move(other.m_freeSlots);
+				m_slotCount = other.m_slotCount;
+				other.m_entries.clear();
+				other.m_slotCount = 0;
+			}
+			return *this;
+		}
+
+		~SplitHeap() { destroyElements(); }
+
+		// Return number of elements in the heap
+		using Base::size;
+
+		// Add new element built in place from its constructor parameters and update the heap
+		// Throws std::length_error if the number of slots exceeds 32-bit range
+		template<typename... Args> void insert(Args&&... item)
+		{
+			const uint32_t slot = allocateSlot();
+			T* element = new (slotAddress(slot)) T(std::forward<Args>(item)...);
+
+			m_entries.push_back({ KeyOf()(*element), slot });
+			Base::bubbleUp(Base::getLastIndex());
+		}
+
+		// Return the front element
+		const T& top() { return *slotPtr(m_entries[TopIdx].slot); }
+
+		// Return the key of the front element
+		const Key& topKey() { return m_entries[TopIdx].key; }
+
+		// Remove and return the front element, update the heap
+		T extractTop()
+		{
+			const uint32_t slot = m_entries[TopIdx].slot;
+			T* element = slotPtr(slot);
+
+			T top = std::move(*element);
+			element->~T();
+			m_freeSlots.push_back(slot);
+
+			Base::removeItemFromHeap(TopIdx);
+			return top;
+		}
+
+	private:
+
+		using Base::TopIdx;
+
+		// Slab chunk is an array of raw element storage
+		using SlotStorage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+		constexpr static IndexType ChunkSize = 1024;
+
+		GenericVector<Entry> m_entries; // Storage of the heap data
+
+		GenericVector< std::unique_ptr<SlotStorage[]> > m_chunks; // Slab of elements
+		GenericVector<uint32_t> m_freeSlots; // Released slots for reuse
+		IndexType m_slotCount = 0; // Number of slots ever allocated
+
+		uint32_t allocateSlot()
+		{
+			if (!m_freeSlots.empty())
+			{
+				uint32_t slot = m_freeSlots.back();
+				m_freeSlots.pop_back();
+				return slot;
+			}
+
+			if (m_slotCount > std::numeric_limits<uint32_t>::max())
+				throw std::length_error("SplitHeap slot ids exhausted");
+
+			if (m_slotCount == m_chunks.size() * ChunkSize)
+				m_chunks.emplace_back(new SlotStorage[ChunkSize]);
+
+			return static_cast<uint32_t>(m_slotCount++);
+		}
+
+		void* slotAddress(uint32_t slot) { return &m_chunks[slot / ChunkSize][slot % ChunkSize]; }
+
+		T* slotPtr(uint32_t slot) { return std::launder(reinterpret_cast<T*>(slotAddress(slot))); }
+
+		// Destroys elements still referenced by the heap
+		void destroyElements()
+		{
+			for (const auto& entry : m_entries)
+				slotPtr(entry.slot)->~T();
+			m_entries.clear();
+		}
+
+	}; // End of class SplitHeap
+
+	// Heap of elements ordered by their keys, selecting SplitHeap layout when the element is much bigger
+	// than a key with slot id and the plain contiguous Heap for small elements
+	template <typename T, typename KeyOf, typename Comparer = std::less< HeapKey<T, KeyOf> > >
+	using KeyedHeap = std::conditional_t< (sizeof(T) > 2 * sizeof(SplitHeapEntry< HeapKey<T, KeyOf> >)),
+		SplitHeap<T, KeyOf, Comparer>,
+		Heap< T, KeyComparer<T, KeyOf, Comparer> > >;
+
+}
@@ -0,0 +1,886 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "StringDistance.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GADS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+namespace // bit-parallel kernels
+{
+
+    constexpr GADS::IndexType WordBits = 64;
+    constexpr GADS::IndexType SymbolCount = std::numeric_limits<unsigned char>::max() + 1;
+
+    GADS::IndexType popCount(uint64_t val)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(val);
+#else
+        GADS::IndexType result = 0;
+        for (; val; val &= val - 1)
+            result++;
+        return result;
+#endif
+    }
+
+    // Match masks of the pattern split to words: bit i of word w of symbol c is set if pattern[64 * w + i] is c
+    // Words of every symbol are stored contiguously, padded with empty words up to wordStride.
+    // Masks of the extra symbol SymbolCount are empty.
+    GADS::GenericVector<uint64_t> buildMatchMasks(std::string_view pattern, GADS::IndexType wordStride)
+    {
+        GADS::GenericVector<uint64_t> masks((SymbolCount + 1) * wordStride, 0);
+        for (GADS::IndexType i = 0; i < pattern.size(); i++)
+            masks[static_cast<unsigned char>(pattern[i]) * wordStride + i / WordBits] |= uint64_t(1) << (i % WordBits);
+        return masks;
+    }
+
+    // Zero bits of the first m bits of the column are matched pattern characters
+    GADS::IndexType countMatched(const uint64_t* column, GADS::IndexType m)
+    {
+        GADS::IndexType result = 0;
+        for (GADS::IndexType w = 0; w * WordBits < m; w++)
+        {
+            const GADS::IndexType bits = std::min(WordBits, m - w * WordBits);
+            const uint64_t valid = (bits == WordBits) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+            result += popCount(~column[w] & valid);
+        }
+        return result;
+    }
+
+    // Sum of a, b and carry, carry is set to the carry out
+    inline uint64_t addWithCarry(uint64_t a, uint64_t b, unsigned char& carry)
+    {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        unsigned long long sum;
+        carry = _addcarry_u64(carry, a, b, &sum);
+        return sum;
+#else
+        const uint64_t partial = a + b;
+        const uint64_t sum = partial + carry;
+        carry = (partial < a) | (sum < partial);
+        return sum;
+#endif
+    }
+
+    // Column update V' = (V + (V & M)) | (V & ~M), the addition carries across words
+    // Returns the column after all text characters: zero bits of its first j bits count LCS(text, pattern[0, j))
+    GADS::GenericVector<uint64_t> lcsColumnScalar(std::string_view text, std::string_view pattern)
+    {
+        const GADS::IndexType words = (pattern.size() + WordBits - 1) / WordBits;
+        const GADS::GenericVector<uint64_t> masks = buildMatchMasks(pattern, words);
+        GADS::GenericVector<uint64_t> column(words, ~uint64_t(0));
+
+        if (words == 1)
+        {
+            uint64_t v = ~uint64_t(0);
+            for (const char c : text)
+            {
+                const uint64_t match = masks[static_cast<unsigned char>(c)];
+                v = (v + (v & match)) | (v & ~match);
+            }
+            column[0] = v;
+        }
+        else
+        {
+            for (const char c : text)
+            {
+                const uint64_t* match = &masks[static_cast<unsigned char>(c) * words];
+                unsigned char carry = 0;
+                for (GADS::IndexType w = 0; w < words; w++)
+                {
+                    const uint64_t v = column[w];
+                    const uint64_t sum = addWithCarry(v, v & match[w], carry);
+                    column[w] = sum | (v & ~match[w]);
+                }
+            }
+        }
+
+        return column;
+    }
+
+#ifdef GADS_X86_KERNELS
+
+    // Lanes where a < b as unsigned 64-bit integers
+    __attribute__((target("avx2")))
+    inline __m256i lessUnsigned(__m256i a, __m256i b)
+    {
+        const __m256i signBit = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(b, signBit), _mm256_xor_si256(a, signBit));
+    }
+
+    // Match masks of groups of 4 words, ordered by group, symbol and word, so that masks of a group take
+    // a contiguous block. Masks of the extra symbol SymbolCount are empty.
+    GADS::GenericVector<uint64_t> buildGroupedMatchMasks(std::string_view pattern, GADS::IndexType lanes)
+    {
+        const GADS::IndexType groupSize = (SymbolCount + 1) * lanes;
+        const GADS::IndexType groups = (pattern.size() + lanes * WordBits - 1) / (lanes * WordBits);
+
+        GADS::GenericVector<uint64_t> masks(groups * groupSize, 0);
+        for (GADS::IndexType i = 0; i < pattern.size(); i++)
+        {
+            const GADS::IndexType word = i / WordBits;
+            masks[word / lanes * groupSize + static_cast<unsigned char>(pattern[i]) * lanes + word % lanes] |= uint64_t(1) << (i % WordBits);
+        }
+        return masks;
+    }
+
+    // Groups of 4 words are processed in lanes delayed by one text character each: at step t lane k updates
+    // word k of the group for text character t - k, using the carry lane k - 1 produced at the previous step.
+    // Carries leaving the group for every text character are kept for the lane 0 of the next group.
+    // The text is processed in tiles keeping the carries in L1 cache, lanes outside of the tile get the empty
+    // match mask of the extra symbol and no carry, which leaves their words unchanged.
+    __attribute__((target("avx2")))
+    GADS::GenericVector<uint64_t> lcsColumnAvx2(std::string_view text, std::string_view pattern)
+    {
+        constexpr GADS::IndexType Lanes = 4;
+        constexpr GADS::IndexType TileSize = 1024;
+        constexpr GADS::IndexType GroupMasks = (SymbolCount + 1) * Lanes;
+
+        const GADS::IndexType n = text.size();
+        const GADS::IndexType words = (pattern.size() + WordBits - 1) / WordBits;
+        const GADS::IndexType stride = (words + Lanes - 1) / Lanes * Lanes;
+        const GADS::GenericVector<uint64_t> masks = buildGroupedMatchMasks(pattern, Lanes);
+        GADS::GenericVector<uint64_t> column(stride, ~uint64_t(0));
+        GADS::GenericVector<uint64_t> carries(TileSize + Lanes - 1, 0); // Carry masks into the current group per text character of the tile
+        GADS::IndexVct rows(Lanes - 1 + TileSize + Lanes - 1); // Mask offsets of the tile characters between empty ones
+
+        for (GADS::IndexType tile = 0; tile < n; tile += TileSize)
+        {
+            const GADS::IndexType tileSize = std::min(n - tile, TileSize);
+            std::fill(rows.begin(), rows.end(), SymbolCount * Lanes);
+            for (GADS::IndexType i = 0; i < tileSize; i++)
+                rows[Lanes - 1 + i] = static_cast<unsigned char>(text[tile + i]) * Lanes;
+            std::fill(carries.begin(), carries.end(), 0);
+
+            for (GADS::IndexType group = 0; group < stride; group += Lanes)
+            {
+                const uint64_t* groupMasks = &masks[group / Lanes * GroupMasks];
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&column[group]));
+                __m256i carry = _mm256_setzero_si256(); // All ones in lanes with a carry
+
+                for (GADS::IndexType step = 0; step < tileSize + Lanes - 1; step++)
+                {
+                    // Carries move one lane up, lane 0 takes the carry of the previous group
+                    carry = _mm256_permute4x64_epi64(carry, _MM_SHUFFLE(2, 1, 0, 3));
+                    carry = _mm256_blend_epi32(carry, _mm256_set1_epi64x(static_cast<int64_t>(carries[step])), 0x03);
+
+                    const GADS::IndexType* row = &rows[step + Lanes - 1]; // Lane k takes character step - k
+                    const __m256i match = _mm256_set_epi64x(static_cast<int64_t>(groupMasks[row[-3] + 3]), static_cast<int64_t>(groupMasks[row[-2] + 2]),
+                        static_cast<int64_t>(groupMasks[row[-1] + 1]), static_cast<int64_t>(groupMasks[row[0]]));
+                    const __m256i u = _mm256_and_si256(v, match);
+                    const __m256i partial = _mm256_add_epi64(v, u);
+                    const __m256i sum = _mm256_sub_epi64(partial, carry);
+                    carry = _mm256_or_si256(lessUnsigned(partial, v), lessUnsigned(sum, partial));
+                    v = _mm256_or_si256(sum, _mm256_andnot_si256(match, v));
+
+                    if (step >= Lanes - 1)
+                        carries[step - (Lanes - 1)] = static_cast<uint64_t>(_mm256_extract_epi64(carry, 3));
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&column[group]), v);
+            }
+        }
+
+        return column;
+    }
+
+#endif
+
+    // Column of the best kernel allowed by simd, the AVX2 kernel pays off once the column spans several groups
+    GADS::GenericVector<uint64_t> lcsColumn(std::string_view text, std::string_view pattern, GADS::SimdLevel simd)
+    {
+#ifdef GADS_X86_KERNELS
+        if (simd >= GADS::SimdLevel::AVX2 && GADS::supportedSimdLevel() >= GADS::SimdLevel::AVX2 && pattern.size() > 2 * WordBits)
+            return lcsColumnAvx2(text, pattern);
+#else
+        (void)simd;
+#endif
+        return lcsColumnScalar(text, pattern);
+    }
+
+} // End of anonymous namespace
+
+GADS::SimdLevel GADS::supportedSimdLevel()
+{
+#ifdef GADS_X86_KERNELS
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2
+        : (__builtin_cpu_supports("sse2") ? SimdLevel::SSE2 : SimdLevel::None);
+    return level;
+#else
+    return SimdLevel::None;
+#endif
+}
+
+// The shorter string is the packed pattern
+GADS::IndexType GADS::longestCommonSubsequenceLength(std::string_view s1, std::string_view s2, SimdLevel simd)
+{
+    const std::string_view pattern = (s1.size() <= s2.size()) ? s1 : s2;
+    const std::string_view text = (s1.size() <= s2.size()) ? s2 : s1;
+    if (pattern.empty())
+        return 0;
+
+    return countMatched(lcsColumn(text, pattern, simd).data(), pattern.size());
+}
+
+namespace // longest common subsequence reconstruction
+{
+
+    // Numbers of zero bits in prefixes [0, j) of the first m bits of the column for j from 0 to m
+    GADS::IndexVct matchedPrefixCounts(const GADS::GenericVector<uint64_t>& column, GADS::IndexType m)
+    {
+        GADS::IndexVct counts(m + 1, 0);
+        for (GADS::IndexType j = 0; j < m; j++)
+            counts[j + 1] = counts[j] + ((~column[j / WordBits] >> (j % WordBits)) & 1);
+        return counts;
+    }
+
+    // Hirschberg's recursion: s1 is halved and s2 split where LCS of the first halves plus LCS of the second halves
+    // is the largest. Both rows come from bit-parallel columns, the second one over the reversed strings r1 and r2.
+    void appendWitness(std::string_view s1, std::string_view s2, std::string_view r1, std::string_view r2, GADS::SimdLevel simd, std::string& out)
+    {
+        const GADS::IndexType n = s1.size();
+        const GADS::IndexType m = s2.size();
+        if (n == 0 || m == 0)
+            return;
+        if (n == 1)
+        {
+            if (s2.find(s1[0]) != std::string_view::npos)
+                out += s1[0];
+            return;
+        }
+
+        const GADS::IndexType mid = n / 2;
+        const GADS::IndexVct forward = matchedPrefixCounts(lcsColumn(s1.substr(0, mid), s2, simd), m); // LCS with s2[0, j)
+        const GADS::IndexVct backward = matchedPrefixCounts(lcsColumn(r1.substr(0, n - mid), r2, simd), m); // LCS with s2[m - j, m)
+
+        GADS::IndexType split = 0;
+        for (GADS::IndexType j = 1; j <= m; j++)
+        {
+            if (forward[j] + backward[m - j] > forward[split] + backward[m - split])
+                split = j;
+        }
+
+        appendWitness(s1.substr(0, mid), s2.substr(0, split), r1.substr(n - mid), r2.substr(m - split), simd, out);
+        appendWitness(s1.substr(mid), s2.substr(split), r1.substr(0, n - mid), r2.substr(0, m - split), simd, out);
+    }
+
+    // Positions of the next occurrence of every symbol at or after every position of s, s.size() if there is none
+    // Row of position i holds symbolCount entries
+    GADS::IndexVct buildNextOccurrences(std::string_view s, const GADS::GenericVector<unsigned char>& symbols)
+    {
+        const GADS::IndexType symbolCount = symbols.size();
+        GADS::IndexVct next((s.size() + 1) * symbolCount, s.size());
+        for (GADS::IndexType i = s.size(); i-- > 0;)
+        {
+            std::copy(next.begin() + (i + 1) * symbolCount, next.begin() + (i + 2) * symbolCount, next.begin() + i * symbolCount);
+            const auto symbol = std::lower_bound(symbols.begin(), symbols.end(), static_cast<unsigned char>(s[i]));
+            if (symbol != symbols.end() && *symbol == static_cast<unsigned char>(s[i]))
+                next[i * symbolCount + (symbol - symbols.begin())] = i;
+        }
+        return next;
+    }
+
+} // End of anonymous namespace
+
+GADS::IndexType GADS::longestCommonSubsequenceWitness(std::string_view s1, std::string_view s2, std::string& witness, SimdLevel simd)
+{
+    const std::string r1(s1.rbegin(), s1.rend());
+    const std::string r2(s2.rbegin(), s2.rend());
+
+    witness.clear();
+    appendWitness(s1, s2, r1, r2, simd, witness);
+    return witness.size();
+}
+
+// Depth first search over LCS of suffix pairs: from positions (i, j) the next symbol c is taken at its first
+// occurrences i' and j' if LCS of the suffixes after them is one shorter. First occurrences leave the longest
+// suffixes, so every distinct subsequence has exactly one path and no path is a dead end.
+GADS::GenericVector<std::string> GADS::longestCommonSubsequences(std::string_view s1, std::string_view s2, IndexType maxCount)
+{
+    const IndexType n = s1.size();
+    const IndexType m = s2.size();
+
+    GenericVector<std::string> result;
+    if (maxCount == 0 || n == 0 || m == 0)
+        return result;
+
+    // Symbols present in both strings, in increasing order of unsigned codes
+    GenericVector<bool> inFirst(SymbolCount, false);
+    GenericVector<bool> inBoth(SymbolCount, false);
+    for (const char c : s1)
+        inFirst[static_cast<unsigned char>(c)] = true;
+    for (const char c : s2)
+        inBoth[static_cast<unsigned char>(c)] = inFirst[static_cast<unsigned char>(c)];
+    GenericVector<unsigned char> symbols;
+    for (IndexType c = 0; c < SymbolCount; c++)
+    {
+        if (inBoth[c])
+            symbols.push_back(static_cast<unsigned char>(c));
+    }
+
+    // LCS of suffixes s1[i, n) and s2[j, m)
+    GenericVector<uint32_t> suffixLcs((n + 1) * (m + 1), 0);
+    auto lcsAt = [&suffixLcs, m](IndexType i, IndexType j) -> uint32_t& { return suffixLcs[i * (m + 1) + j]; };
+    for (IndexType i = n; i-- > 0;)
+    {
+        for (IndexType j = m; j-- > 0;)
+            lcsAt(i, j) = (s1[i] == s2[j]) ? lcsAt(i + 1, j + 1) + 1 : std::max(lcsAt(i + 1, j), lcsAt(i, j + 1));
+    }
+    if (lcsAt(0, 0) == 0)
+        return result;
+
+    const IndexType symbolCount = symbols.size();
+    const IndexVct next1 = buildNextOccurrences(s1, symbols);
+    const IndexVct next2 = buildNextOccurrences(s2, symbols);
+
+    struct Frame
+    {
+        IndexType i;
+        IndexType j;
+        IndexType symbol; // Next symbol to try
+    };
+
+    GenericVector<Frame> path = { { 0, 0, 0 } };
+    std::string current; // Symbols taken by the frames after the first one
+    while (!path.empty() && result.size() < maxCount)
+    {
+        Frame& frame = path.back();
+        const uint32_t remaining = lcsAt(frame.i, frame.j);
+        if (remaining == 0)
+            result.push_back(current);
+
+        bool extended = false;
+        while (remaining > 0 && frame.symbol < symbolCount)
+        {
+            const IndexType k = frame.symbol++;
+            const IndexType i = next1[frame.i * symbolCount + k];
+            const IndexType j = next2[frame.j * symbolCount + k];
+            if (i < n && j < m && lcsAt(i + 1, j + 1) + 1 == remaining)
+            {
+                current.push_back(static_cast<char>(symbols[k]));
+                path.push_back({ i + 1, j + 1, 0 });
+                extended = true;
+                break;
+            }
+        }
+
+        if (!extended)
+        {
+            path.pop_back();
+            if (!current.empty())
+                current.pop_back();
+        }
+    }
+
+    return result;
+}
+
+namespace // bit-parallel edit distance
+{
+
+    constexpr uint64_t HighBit = uint64_t(1) << (WordBits - 1);
+
+    // Advances a block of 64 rows of the edit distance column by one text character (Myers in Hyyro's formulation)
+    // positive and negative are the rows whose value is one more or one less than the row above, match the rows
+    // equal to the character. hin is the change of the row above the block, returns the change of the row of outBit.
+    inline int advanceBlock(uint64_t& positive, uint64_t& negative, uint64_t match, int hin, uint64_t outBit)
+    {
+        const uint64_t hinPositive = (hin > 0) ? 1 : 0;
+        const uint64_t hinNegative = (hin < 0) ? 1 : 0;
+
+        const uint64_t xv = match | negative;
+        match |= hinNegative;
+        const uint64_t xh = (((match & positive) + positive) ^ positive) | match;
+        uint64_t horizontalPositive = negative | ~(xh | positive);
+        uint64_t horizontalNegative = positive & xh;
+        const int hout = int((horizontalPositive & outBit) != 0) - int((horizontalNegative & outBit) != 0);
+
+        horizontalPositive = (horizontalPositive << 1) | hinPositive;
+        horizontalNegative = (horizontalNegative << 1) | hinNegative;
+        positive = horizontalNegative | ~(xv | horizontalPositive);
+        negative = horizontalPositive & xv;
+        return hout;
+    }
+
+    // Unit cost edit distance of text and pattern if at most k, otherwise k + 1. The text is not shorter.
+    // Only cells on diagonals d = column - row with |d| + |d - delta| <= k, delta = n - m, can be on an alignment
+    // of cost k, blocks outside of them are skipped. A skipped block above is treated as growing by one per column
+    // and a block entering the band starts from the block above plus one per row, both are never below the real
+    // values of cells off the band, so every cell of the band with a value up to k stays exact.
+    GADS::IndexType boundedEditDistance(std::string_view text, std::string_view pattern, GADS::IndexType k)
+    {
+        const GADS::IndexType n = text.size();
+        const GADS::IndexType m = pattern.size();
+        const GADS::IndexType delta = n - m;
+        if (delta > k)
+            return k + 1;
+        if (m == 0)
+            return n;
+
+        const GADS::IndexType above = (k + delta) / 2; // Rows of column j are at least j - above
+        const GADS::IndexType below = (k - delta) / 2; // and at most j + below
+
+        const GADS::IndexType blockCount = (m + WordBits - 1) / WordBits;
+        const GADS::IndexType lastBits = m - (blockCount - 1) * WordBits;
+        const uint64_t lastOutBit = uint64_t(1) << (lastBits - 1);
+        const uint64_t lastValid = (lastBits == WordBits) ? ~uint64_t(0) : (lastOutBit << 1) - 1;
+        const GADS::GenericVector<uint64_t> masks = buildMatchMasks(pattern, blockCount);
+
+        // Column 0: every row is one more than the row above, scores are values of the bottom rows of the blocks
+        GADS::GenericVector<uint64_t> positive(blockCount, ~uint64_t(0));
+        GADS::GenericVector<uint64_t> negative(blockCount, 0);
+        GADS::IndexVct scores(blockCount);
+        for (GADS::IndexType b = 0; b < blockCount; b++)
+            scores[b] = std::min((b + 1) * WordBits, m);
+
+        GADS::IndexType firstBlock = 0;
+        GADS::IndexType lastBlock = (std::min(m, 1 + below) - 1) / WordBits;
+        const bool bounded = k < n;
+        for (GADS::IndexType j = 1; j <= n; j++)
+        {
+            // Band of column j, a block entering it starts from the bottom row of the block above in column j - 1
+            const GADS::IndexType newLastBlock = (std::min(m, j + below) - 1) / WordBits;
+            if (newLastBlock > lastBlock)
+            {
+                lastBlock = newLastBlock;
+                positive[lastBlock] = ~uint64_t(0);
+                negative[lastBlock] = 0;
+                scores[lastBlock] = scores[lastBlock - 1] + std::min(WordBits, m - lastBlock * WordBits);
+            }
+            if (j > above)
+                firstBlock = std::max(firstBlock, (j - above - 1) / WordBits);
+
+            // Row 0 and the rows of skipped blocks above grow by one
+            const uint64_t* charMasks = &masks[static_cast<unsigned char>(text[j - 1]) * blockCount];
+            int hin = 1;
+            bool exceeded = bounded;
+            for (GADS::IndexType b = firstBlock; b <= lastBlock; b++)
+            {
+                const bool last = (b + 1 == blockCount);
+                hin = advanceBlock(positive[b], negative[b], charMasks[b], hin, last ? lastOutBit : HighBit);
+                scores[b] += hin;
+
+                // No row of the block can be smaller than its bottom row minus the rows growing downwards
+                exceeded = exceeded && scores[b] > k + popCount(positive[b] & (last ? lastValid : ~uint64_t(0)));
+            }
+
+            // Every alignment crosses the band of the column, there are only cells over k
+            if (exceeded)
+                return k + 1;
+        }
+
+        const GADS::IndexType distance = scores.back();
+        return (distance <= k) ? distance : k + 1;
+    }
+
+} // End of anonymous namespace
+
+GADS::IndexType GADS::editDistance(std::string_view s1, std::string_view s2)
+{
+    return editDistanceWithin(s1, s2, std::numeric_limits<IndexType>::max());
+}
+
+// The shorter string is the packed pattern, the distance never exceeds the longer length
+GADS::IndexType GADS::editDistanceWithin(std::string_view s1, std::string_view s2, IndexType k)
+{
+    const std::string_view pattern = (s1.size() <= s2.size()) ? s1 : s2;
+    const std::string_view text = (s1.size() <= s2.size()) ? s2 : s1;
+
+    return boundedEditDistance(text, pattern, std::min(k, text.size()));
+}
+
+// Implementation of EditCostTable
+
+GADS::EditCostTable::EditCostTable()
+    : substitution(SymbolCount * SymbolCount, 1), insertion(SymbolCount, 1), deletion(SymbolCount, 1)
+{
+    for (IndexType c = 0; c < SymbolCount; c++)
+        substitution[c * SymbolCount + c] = 0;
+}
+
+GADS::EditCostTable::EditCostTable(const MatchConfig& config)
+    : substitution(SymbolCount * SymbolCount), insertion(SymbolCount), deletion(SymbolCount)
+{
+    for (IndexType c1 = 0; c1 < SymbolCount; c1++)
+    {
+        setInsertCost(static_cast<char>(c1), config.insertCost(static_cast<char>(c1)));
+        setDeleteCost(static_cast<char>(c1), config.deleteCost(static_cast<char>(c1)));
+        for (IndexType c2 = 0; c2 < SymbolCount; c2++)
+            setMatchCost(static_cast<char>(c1), static_cast<char>(c2), config.matchCost(static_cast<char>(c1), static_cast<char>(c2)));
+    }
+}
+
+void GADS::EditCostTable::setMatchCost(char c1, char c2, ValueType cost)
+{
+    if (cost < 0)
+        throw std::invalid_argument("Edit costs must be non-negative");
+    substitution[code(c1) * SymbolCount + code(c2)] = cost;
+}
+
+void GADS::EditCostTable::setInsertCost(char c, ValueType cost)
+{
+    if (cost < 0)
+        throw std::invalid_argument("Edit costs must be non-negative");
+    insertion[code(c)] = cost;
+}
+
+void GADS::EditCostTable::setDeleteCost(char c, ValueType cost)
+{
+    if (cost < 0)
+        throw std::invalid_argument("Edit costs must be non-negative");
+    deletion[code(c)] = cost;
+}
+
+namespace // striped weighted edit distance
+{
+
+    // Costs seen by the striped kernel: rows are characters of the shorter string, columns of the longer one
+    // If the rows are s2 the moves swap, entering a row inserts and entering a column deletes.
+    class OrientedCosts
+    {
+    public:
+        OrientedCosts(const GADS::EditCostTable& table, bool rowsAreFirst) : table(table), rowsAreFirst(rowsAreFirst) {}
+
+        int64_t rowStep(char r) const { return rowsAreFirst ? table.deleteCost(r) : table.insertCost(r); }
+        int64_t columnStep(char c) const { return rowsAreFirst ? table.insertCost(c) : table.deleteCost(c); }
+        int64_t pair(char r, char c) const { return rowsAreFirst ? table.matchCost(r, c) : table.matchCost(c, r); }
+
+    private:
+        const GADS::EditCostTable& table;
+        const bool rowsAreFirst;
+    };
+
+#ifdef GADS_X86_KERNELS
+
+    // Lanes of the striped kernel: Count values of a vector whose additions saturate at Cap, standing for infinity
+    // shift moves values towards the higher lanes by Distance, zeros enter. Intrinsics stay in these members,
+    // so the kernel template compiles for every instruction set.
+
+    struct Sse2Lanes8
+    {
+        using Vec = __m128i;
+        using Value = uint8_t;
+        static constexpr GADS::IndexType Count = 16;
+        static constexpr int64_t Cap = 255;
+
+        static Vec load(const Value* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+        static void store(Value* p, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(p), v); }
+        static Vec splat(Value v) { return _mm_set1_epi8(static_cast<char>(v)); }
+        static Vec add(Vec a, Vec b) { return _mm_adds_epu8(a, b); }
+        static Vec min(Vec a, Vec b) { return _mm_min_epu8(a, b); }
+        static bool anyLess(Vec a, Vec b) { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(a, b), b)) != 0xFFFF; }
+        static Vec shiftIn(Vec v, Value first) { return _mm_or_si128(_mm_slli_si128(v, 1), _mm_cvtsi32_si128(first)); }
+        template <GADS::IndexType Distance> static Vec shift(Vec v) { return _mm_slli_si128(v, Distance); }
+    };
+
+    struct Sse2Lanes16
+    {
+        using Vec = __m128i;
+        using Value = int16_t;
+        static constexpr GADS::IndexType Count = 8;
+        static constexpr int64_t Cap = std::numeric_limits<int16_t>::max();
+
+        static Vec load(const Value* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+        static void store(Value* p, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(p), v); }
+        static Vec splat(Value v) { return _mm_set1_epi16(v); }
+        static Vec add(Vec a, Vec b) { return _mm_adds_epi16(a, b); }
+        static Vec min(Vec a, Vec b) { return _mm_min_epi16(a, b); }
+        static bool anyLess(Vec a, Vec b) { return _mm_movemask_epi8(_mm_cmpgt_epi16(b, a)) != 0; }
+        static Vec shiftIn(Vec v, Value first) { return _mm_or_si128(_mm_slli_si128(v, 2), _mm_cvtsi32_si128(first)); }
+        template <GADS::IndexType Distance> static Vec shift(Vec v) { return _mm_slli_si128(v, 2 * Distance); }
+    };
+
+    // No saturating 32-bit addition, sums of two values up to Cap, half of the range, are clamped back
+    struct Sse2Lanes32
+    {
+        using Vec = __m128i;
+        using Value = int32_t;
+        static constexpr GADS::IndexType Count = 4;
+        static constexpr int64_t Cap = std::numeric_limits<int32_t>::max() / 2;
+
+        static Vec load(const Value* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+        static void store(Value* p, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(p), v); }
+        static Vec splat(Value v) { return _mm_set1_epi32(v); }
+        static Vec add(Vec a, Vec b) { return min(_mm_add_epi32(a, b), splat(Cap)); }
+        static Vec min(Vec a, Vec b)
+        {
+            const Vec greater = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+        }
+        static bool anyLess(Vec a, Vec b) { return _mm_movemask_epi8(_mm_cmpgt_epi32(b, a)) != 0; }
+        static Vec shiftIn(Vec v, Value first) { return _mm_or_si128(_mm_slli_si128(v, 4), _mm_cvtsi32_si128(first)); }
+        template <GADS::IndexType Distance> static Vec shift(Vec v) { return _mm_slli_si128(v, 4 * Distance); }
+    };
+
+    // Shift of all 32 bytes of v towards the higher lanes by Bytes, zeros enter
+    template <GADS::IndexType Bytes> __attribute__((target("avx2"))) inline __m256i shiftBytesAvx2(__m256i v)
+    {
+        if constexpr (Bytes >= 16)
+            return _mm256_slli_si256(_mm256_permute2x128_si256(v, v, 0x08), Bytes - 16);
+        else
+            return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 16 - Bytes);
+    }
+
+    struct Avx2Lanes8
+    {
+        using Vec = __m256i;
+        using Value = uint8_t;
+        static constexpr GADS::IndexType Count = 32;
+        static constexpr int64_t Cap = 255;
+
+        __attribute__((target("avx2"))) static Vec load(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p)); }
+        __attribute__((target("avx2"))) static void store(Value* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(p), v); }
+        __attribute__((target("avx2"))) static Vec splat(Value v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+        __attribute__((target("avx2"))) static Vec add(Vec a, Vec b) { return _mm256_adds_epu8(a, b); }
+        __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) { return _mm256_min_epu8(a, b); }
+        __attribute__((target("avx2"))) static bool anyLess(Vec a, Vec b) { return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), b)) != -1; }
+        __attribute__((target("avx2"))) static Vec shiftIn(Vec v, Value first) { return _mm256_or_si256(shiftBytesAvx2<1>(v), _mm256_setr_epi32(first, 0, 0, 0, 0, 0, 0, 0)); }
+        template <GADS::IndexType Distance> __attribute__((target("avx2"))) static Vec shift(Vec v) { return shiftBytesAvx2<1 * Distance>(v); }
+    };
+
+    struct Avx2Lanes16
+    {
+        using Vec = __m256i;
+        using Value = int16_t;
+        static constexpr GADS::IndexType Count = 16;
+        static constexpr int64_t Cap = std::numeric_limits<int16_t>::max();
+
+        __attribute__((target("avx2"))) static Vec load(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p)); }
+        __attribute__((target("avx2"))) static void store(Value* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(p), v); }
+        __attribute__((target("avx2"))) static Vec splat(Value v) { return _mm256_set1_epi16(v); }
+        __attribute__((target("avx2"))) static Vec add(Vec a, Vec b) { return _mm256_adds_epi16(a, b); }
+        __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) { return _mm256_min_epi16(a, b); }
+        __attribute__((target("avx2"))) static bool anyLess(Vec a, Vec b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi16(b, a)) != 0; }
+        __attribute__((target("avx2"))) static Vec shiftIn(Vec v, Value first) { return _mm256_or_si256(shiftBytesAvx2<2>(v), _mm256_setr_epi32(first, 0, 0, 0, 0, 0, 0, 0)); }
+        template <GADS::IndexType Distance> __attribute__((target("avx2"))) static Vec shift(Vec v) { return shiftBytesAvx2<2 * Distance>(v); }
+    };
+
+    struct Avx2Lanes32
+    {
+        using Vec = __m256i;
+        using Value = int32_t;
+        static constexpr GADS::IndexType Count = 8;
+        static constexpr int64_t Cap = std::numeric_limits<int32_t>::max() / 2;
+
+        __attribute__((target("avx2"))) static Vec load(const Value* p) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p)); }
+        __attribute__((target("avx2"))) static void store(Value* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(p), v); }
+        __attribute__((target("avx2"))) static Vec splat(Value v) { return _mm256_set1_epi32(v); }
+        __attribute__((target("avx2"))) static Vec add(Vec a, Vec b) { return _mm256_min_epi32(_mm256_add_epi32(a, b), splat(Cap)); }
+        __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+        __attribute__((target("avx2"))) static bool anyLess(Vec a, Vec b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi32(b, a)) != 0; }
+        __attribute__((target("avx2"))) static Vec shiftIn(Vec v, Value first) { return _mm256_or_si256(shiftBytesAvx2<4>(v), _mm256_setr_epi32(first, 0, 0, 0, 0, 0, 0, 0)); }
+        template <GADS::IndexType Distance> __attribute__((target("avx2"))) static Vec shift(Vec v) { return shiftBytesAvx2<4 * Distance>(v); }
+    };
+
+// Kernel templates have no target of its own, they are always inlined into a wrapper of its instruction set
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+    // Min-plus prefix scan over the lanes of values: lane l becomes the minimum over l' <= l of values[l'] plus
+    // the weight of lanes l' + 1 to l, by doubling distances. weights holds one vector per distance, its lane l
+    // the weight of the Distance lanes ending at l, or the cap if they do not exist.
+    template <typename Lanes, GADS::IndexType Distance = 1>
+    inline __attribute__((always_inline)) void scanLanes(typename Lanes::Vec& values, const typename Lanes::Value* weights)
+    {
+        if constexpr (Distance < Lanes::Count)
+        {
+            values = Lanes::min(values, Lanes::add(Lanes::template shift<Distance>(values), Lanes::load(weights)));
+            scanLanes<Lanes, Distance * 2>(values, weights + Lanes::Count);
+        }
+    }
+
+    // Striped edit distance of the non-empty rows against the non-empty columns, Lanes::Cap if it does not fit
+    // Row r is lane r / segments of vector r % segments. Going down a column the first pass follows deletions
+    // within lanes only, lane 0 starts from row 0. Deletions entering the other lanes are then scanned across
+    // the last rows of the lanes with the costs of going down whole lanes, and a last pass carries them down
+    // each lane while any lane improves. Farrar's lazy loop would instead sweep the column once per lane
+    // reached, which global alignment does on every column below the diagonal.
+    template <typename Lanes>
+    inline __attribute__((always_inline)) int64_t stripedEditDistance(std::string_view rows, std::string_view columns, const OrientedCosts& costs)
+    {
+        using Value = typename Lanes::Value;
+        using Vec = typename Lanes::Vec;
+        constexpr GADS::IndexType lanes = Lanes::Count;
+        auto capped = [](int64_t value) { return static_cast<Value>(std::min(value, Lanes::Cap)); };
+
+        const GADS::IndexType m = rows.size();
+        const GADS::IndexType segments = (m + lanes - 1) / lanes;
+        auto slot = [segments](GADS::IndexType r) { return (r % segments) * lanes + r / segments; };
+
+        // Costs of entering the rows from above, one unused vector at the end, column 0 and costs of going down
+        // through whole lanes
+        GADS::GenericVector<Value> steps((segments + 1) * lanes, 0);
+        GADS::GenericVector<Value> h(segments * lanes, static_cast<Value>(Lanes::Cap));
+        GADS::GenericVector<int64_t> laneCost(lanes, 0);
+        int64_t sum = 0;
+        for (GADS::IndexType r = 0; r < m; r++)
+        {
+            const int64_t step = costs.rowStep(rows[r]);
+            sum += step;
+            steps[slot(r)] = capped(step);
+            h[slot(r)] = capped(sum);
+            laneCost[r / segments] += step;
+        }
+
+        // Scan weights of the lanes passed through, one vector per doubled distance
+        GADS::GenericVector<Value> scanWeights;
+        for (GADS::IndexType distance = 1; distance < lanes; distance *= 2)
+        {
+            for (GADS::IndexType l = 0; l < lanes; l++)
+            {
+                int64_t weight = Lanes::Cap;
+                if (l >= distance)
+                    weight = std::accumulate(laneCost.begin() + (l - distance + 1), laneCost.begin() + (l + 1), int64_t(0));
+                scanWeights.push_back(capped(weight));
+            }
+        }
+
+        // Profiles of the column characters present: aligning them with every row, padding rows are infinite
+        constexpr GADS::IndexType absent = GADS::EditCostTable::SymbolCount;
+        GADS::GenericVector<GADS::IndexType> profileOf(GADS::EditCostTable::SymbolCount, absent);
+        GADS::IndexType profileCount = 0;
+        for (const char c : columns)
+        {
+            GADS::IndexType& profile = profileOf[static_cast<unsigned char>(c)];
+            if (profile == absent)
+                profile = profileCount++;
+        }
+        GADS::GenericVector<Value> profiles(profileCount * segments * lanes, static_cast<Value>(Lanes::Cap));
+        for (GADS::IndexType code = 0; code < GADS::EditCostTable::SymbolCount; code++)
+        {
+            if (profileOf[code] == absent)
+                continue;
+            const char c = static_cast<char>(code);
+            Value* profile = &profiles[profileOf[code] * segments * lanes];
+
+            // Slots in memory order, row l * segments + k is lane l of vector k
+            for (GADS::IndexType k = 0; k < segments; k++)
+            {
+                for (GADS::IndexType l = 0, r = k; l < lanes && r < m; l++, r += segments)
+                    profile[k * lanes + l] = capped(costs.pair(rows[r], c));
+            }
+        }
+
+        const Vec infinity = Lanes::splat(static_cast<Value>(Lanes::Cap));
+        const int64_t firstStep = costs.rowStep(rows[0]);
+        Value* column = h.data();
+        int64_t top = 0; // Row 0 of the previous column
+        for (GADS::IndexType j = 0; j < columns.size(); j++)
+        {
+            const char c = columns[j];
+            const Value* profile = &profiles[profileOf[static_cast<unsigned char>(c)] * segments * lanes];
+            const int64_t step = costs.columnStep(c);
+            const Vec columnStep = Lanes::splat(capped(step));
+
+            Vec diagonal = Lanes::shiftIn(Lanes::load(column + (segments - 1) * lanes), capped(top));
+            top += step;
+            Vec fromAbove = Lanes::shiftIn(infinity, capped(top + firstStep));
+            for (GADS::IndexType k = 0; k < segments; k++)
+            {
+                const Vec left = Lanes::load(column + k * lanes);
+                Vec value = Lanes::min(Lanes::add(diagonal, Lanes::load(profile + k * lanes)), Lanes::add(left, columnStep));
+                value = Lanes::min(value, fromAbove);
+                Lanes::store(column + k * lanes, value);
+                fromAbove = Lanes::add(value, Lanes::load(&steps[(k + 1) * lanes]));
+                diagonal = left;
+            }
+
+            // Lane l is entered from the last row of lane l - 1, which may be reached itself through earlier lanes
+            Vec lastRows = Lanes::load(column + (segments - 1) * lanes);
+            scanLanes<Lanes>(lastRows, scanWeights.data());
+            fromAbove = Lanes::add(Lanes::shiftIn(lastRows, static_cast<Value>(Lanes::Cap)), Lanes::load(steps.data()));
+            for (GADS::IndexType k = 0; k < segments; k++)
+            {
+                const Vec current = Lanes::load(column + k * lanes);
+                if (!Lanes::anyLess(fromAbove, current))
+                    break;
+                const Vec value = Lanes::min(current, fromAbove);
+                Lanes::store(column + k * lanes, value);
+                fromAbove = Lanes::add(value, Lanes::load(&steps[(k + 1) * lanes]));
+            }
+
+            // Minima of the columns do not decrease, once every cell saturates so does the result
+            if (j % 64 == 63)
+            {
+                Vec minimum = infinity;
+                for (GADS::IndexType k = 0; k < segments; k++)
+                    minimum = Lanes::min(minimum, Lanes::load(column + k * lanes));
+                if (!Lanes::anyLess(minimum, infinity))
+                    return Lanes::Cap;
+            }
+        }
+
+        return h[slot(m - 1)];
+    }
+
+#pragma GCC diagnostic pop
+
+    using StripedKernel = int64_t (*)(std::string_view, std::string_view, const OrientedCosts&);
+
+    int64_t stripedSse2Lanes8(std::string_view rows, std::string_view columns, const OrientedCosts& costs) { return stripedEditDistance<Sse2Lanes8>(rows, columns, costs); }
+    int64_t stripedSse2Lanes16(std::string_view rows, std::string_view columns, const OrientedCosts& costs) { return stripedEditDistance<Sse2Lanes16>(rows, columns, costs); }
+    int64_t stripedSse2Lanes32(std::string_view rows, std::string_view columns, const OrientedCosts& costs) { return stripedEditDistance<Sse2Lanes32>(rows, columns, costs); }
+
+    __attribute__((target("avx2"))) int64_t stripedAvx2Lanes8(std::string_view rows, std::string_view columns, const OrientedCosts& costs)
+    {
+        return stripedEditDistance<Avx2Lanes8>(rows, columns, costs);
+    }
+    __attribute__((target("avx2"))) int64_t stripedAvx2Lanes16(std::string_view rows, std::string_view columns, const OrientedCosts& costs)
+    {
+        return stripedEditDistance<Avx2Lanes16>(rows, columns, costs);
+    }
+    __attribute__((target("avx2"))) int64_t stripedAvx2Lanes32(std::string_view rows, std::string_view columns, const OrientedCosts& costs)
+    {
+        return stripedEditDistance<Avx2Lanes32>(rows, columns, costs);
+    }
+
+#endif
+
+} // End of anonymous namespace
+
+// Lane widths from the narrowest: a width is skipped if the distance is surely over its cap, otherwise tried
+// and promoted if the result saturates. Saturated cells never win a minimum, so a result below the cap is exact.
+GADS::IndexType GADS::weightedEditDistance(std::string_view s1, std::string_view s2, const EditCostTable& costs, SimdLevel simd)
+{
+    if (s1.empty() || s2.empty() || simd < SimdLevel::SSE2 || supportedSimdLevel() < SimdLevel::SSE2)
+        return approximativeStringMatching(s1, s2, costs);
+
+#ifdef GADS_X86_KERNELS
+    const bool rowsAreFirst = s1.size() <= s2.size();
+    const OrientedCosts oriented(costs, rowsAreFirst);
+    const std::string_view rows = rowsAreFirst ? s1 : s2;
+    const std::string_view columns = rowsAreFirst ? s2 : s1;
+
+    // The length difference takes at least as many of the cheapest edits
+    int64_t cheapest = std::numeric_limits<int64_t>::max();
+    for (IndexType c = 0; c < EditCostTable::SymbolCount; c++)
+        cheapest = std::min(cheapest, oriented.columnStep(static_cast<char>(c)));
+    const int64_t lower = static_cast<int64_t>(columns.size() - rows.size()) * cheapest;
+
+    const bool avx2 = simd >= SimdLevel::AVX2 && supportedSimdLevel() >= SimdLevel::AVX2;
+    const std::pair<int64_t, StripedKernel> widths[] = {
+        { Sse2Lanes8::Cap, avx2 ? stripedAvx2Lanes8 : stripedSse2Lanes8 },
+        { Sse2Lanes16::Cap, avx2 ? stripedAvx2Lanes16 : stripedSse2Lanes16 },
+        { Sse2Lanes32::Cap, avx2 ? stripedAvx2Lanes32 : stripedSse2Lanes32 } };
+    for (const auto& width : widths)
+    {
+        if (lower >= width.first)
+            continue;
+        const int64_t distance = width.second(rows, columns, oriented);
+        if (distance < width.first)
+            return distance;
+    }
+#endif
+
+    // Over the 32-bit cap, 64-bit scalar costs
+    return approximativeStringMatching(s1, s2, costs);
+}
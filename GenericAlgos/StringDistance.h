@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Vector instruction sets of the string distance kernels, every level includes the previous ones
+    enum class SimdLevel
+    {
+        None, // Portable scalar code
+        SSE2,
+        AVX2
+    };
+
+    // Best level supported by the running CPU and the compiler
+    SimdLevel supportedSimdLevel();
+
+    // Length of the longest common subsequence of s1 and s2 by the bit-parallel algorithm of Allison-Dix and Hyyro
+    // Every character of the longer string updates the dynamic programming column of the shorter one packed in
+    // 64-bit words: O(n * m / 64) time and O(256 * m / 64) memory. With AVX2 four words of the column are updated
+    // at once on an anti-diagonal wavefront. simd limits the instruction set, the CPU may support a lower one.
+    IndexType longestCommonSubsequenceLength(std::string_view s1, std::string_view s2, SimdLevel simd = SimdLevel::AVX2);
+
+    // Finds one longest common subsequence of s1 and s2, stored to witness, and returns its length
+    // Hirschberg's divide and conquer in O(n + m) memory, DP rows of the halves come from the bit-parallel columns.
+    // Time is O(n * m / 64) for the rows, O((n + m) log n) for the splits.
+    IndexType longestCommonSubsequenceWitness(std::string_view s1, std::string_view s2, std::string& witness, SimdLevel simd = SimdLevel::AVX2);
+
+    // Distinct longest common subsequences of s1 and s2 in lexicographic order, at most maxCount of them
+    // Takes O(n * m) time and memory for a table of 32-bit lengths, then O(256) per character of every
+    // subsequence returned, so a cap bounds the work even if the number of subsequences is exponential.
+    // Empty if there is no common character.
+    GenericVector<std::string> longestCommonSubsequences(std::string_view s1, std::string_view s2, IndexType maxCount);
+
+    // Unit cost (Levenshtein) edit distance of s1 and s2 by the bit-parallel algorithm of Myers in Hyyro's formulation
+    // The column of the shorter string is packed in 64-bit blocks updated for every character of the longer one,
+    // O(n * m / 64) time and O(256 * m / 64) memory. Equal to approximativeStringMatching() with UnitCostPolicy.
+    IndexType editDistance(std::string_view s1, std::string_view s2);
+
+    // Unit cost edit distance of s1 and s2 if it is at most k, otherwise k + 1
+    // Only the blocks crossing Ukkonen's band of diagonals reachable by an alignment of cost k are updated,
+    // O(n * k / 64) time, and the scan stops at the first column where all cells of the band exceed k.
+    IndexType editDistanceWithin(std::string_view s1, std::string_view s2, IndexType k);
+
+    // Cost policies of approximativeStringMatching(): CostType is a signed integer, matchCost(c1, c2) is the cost
+    // of aligning c1 of s1 with c2 of s2, insertCost(c) of inserting c of s2 and deleteCost(c) of deleting c of s1.
+    // The kernel calls them directly, so non-virtual members inline into the inner loop.
+
+    // Levenshtein distance, every edit costs 1
+    struct UnitCostPolicy
+    {
+        using CostType = int32_t;
+
+        CostType matchCost(char c1, char c2) const { return (c1 == c2) ? 0 : 1; }
+        CostType insertCost(char) const { return 1; }
+        CostType deleteCost(char) const { return 1; }
+    };
+
+    // Adapter of the virtual MatchConfig interface to a cost policy
+    class MatchConfigCostPolicy
+    {
+    public:
+        using CostType = ValueType;
+
+        explicit MatchConfigCostPolicy(const MatchConfig& config) : config(config) {}
+
+        CostType matchCost(char c1, char c2) const { return config.matchCost(c1, c2); }
+        CostType insertCost(char c) const { return config.insertCost(c); }
+        CostType deleteCost(char c) const { return config.deleteCost(c); }
+
+    private:
+        const MatchConfig& config;
+    };
+
+    // Cheapest alignment of s1 and s2 under the cost policy costs
+    // Borders of the dynamic programming table are sums of the insert and delete costs, the result is its last cell.
+    // Without sequences only one row is kept, O(m) memory. With sequences the full table is filled and traced back,
+    // the container then holds the characters aligned at equal positions of one cheapest alignment.
+    template <typename CostPolicy, typename = std::enable_if_t<!std::is_base_of<MatchConfig, CostPolicy>::value>>
+    typename CostPolicy::CostType approximativeStringMatching(std::string_view s1, std::string_view s2, const CostPolicy& costs,
+        GenericSet<std::string>* sequences = nullptr)
+    {
+        using CostType = typename CostPolicy::CostType;
+        static_assert(std::is_integral<CostType>::value && std::is_signed<CostType>::value, "Costs must be signed integers");
+
+        const IndexType n = s1.size();
+        const IndexType m = s2.size();
+
+        // Row of the empty prefix of s1
+        GenericVector<CostType> row(m + 1);
+        row[0] = 0;
+        for (IndexType j = 1; j <= m; j++)
+            row[j] = row[j - 1] + costs.insertCost(s2[j - 1]);
+
+        if (sequences == nullptr)
+        {
+            for (IndexType i = 1; i <= n; i++)
+            {
+                const char c1 = s1[i - 1];
+                const CostType deleteCost = costs.deleteCost(c1);
+
+                // diagonal holds t[i - 1][j - 1] and left t[i][j - 1] while row[j] still holds t[i - 1][j]
+                CostType diagonal = row[0];
+                CostType left = row[0] + deleteCost;
+                row[0] = left;
+                for (IndexType j = 1; j <= m; j++)
+                {
+                    const CostType up = row[j];
+                    const CostType cost = std::min({ diagonal + costs.matchCost(c1, s2[j - 1]),
+                        left + costs.insertCost(s2[j - 1]), up + deleteCost });
+                    diagonal = up;
+                    left = cost;
+                    row[j] = cost;
+                }
+            }
+            return row[m];
+        }
+
+        // Full table for the traceback, row i starts at i * (m + 1)
+        const IndexType width = m + 1;
+        GenericVector<CostType> t((n + 1) * width);
+        std::copy(row.begin(), row.end(), t.begin());
+        for (IndexType i = 1; i <= n; i++)
+        {
+            const char c1 = s1[i - 1];
+            const CostType deleteCost = costs.deleteCost(c1);
+            CostType* current = &t[i * width];
+            const CostType* previous = current - width;
+
+            current[0] = previous[0] + deleteCost;
+            for (IndexType j = 1; j <= m; j++)
+            {
+                current[j] = std::min({ previous[j - 1] + costs.matchCost(c1, s2[j - 1]),
+                    current[j - 1] + costs.insertCost(s2[j - 1]), previous[j] + deleteCost });
+            }
+        }
+
+        // Walk back from the last cell, preferring aligned characters
+        std::string aligned;
+        for (IndexType i = n, j = m; i > 0 || j > 0;)
+        {
+            const CostType cost = t[i * width + j];
+            if (i > 0 && j > 0 && cost == t[(i - 1) * width + j - 1] + costs.matchCost(s1[i - 1], s2[j - 1]))
+            {
+                if (s1[i - 1] == s2[j - 1])
+                    aligned += s1[i - 1];
+                i--;
+                j--;
+            }
+            else if (i > 0 && cost == t[(i - 1) * width + j] + costs.deleteCost(s1[i - 1]))
+                i--;
+            else
+                j--;
+        }
+        std::reverse(aligned.begin(), aligned.end());
+
+        sequences->clear();
+        sequences->insert(aligned);
+        return t.back();
+    }
+
+
+    // Costs of weighted edit distance as lookup tables over all 256 characters, every cost is non-negative
+    // Also a cost policy of approximativeStringMatching(), with 64-bit costs.
+    class EditCostTable
+    {
+    public:
+        using CostType = int64_t;
+
+        static constexpr IndexType SymbolCount = 256;
+
+        // Unit costs: 0 for equal characters, 1 for every edit
+        EditCostTable();
+
+        // Costs of config for all characters, throws std::invalid_argument if any of them is negative
+        explicit EditCostTable(const MatchConfig& config);
+
+        // Setters throw std::invalid_argument for a negative cost
+        void setMatchCost(char c1, char c2, ValueType cost);
+        void setInsertCost(char c, ValueType cost);
+        void setDeleteCost(char c, ValueType cost);
+
+        // Cost of aligning c1 of s1 with c2 of s2
+        CostType matchCost(char c1, char c2) const { return substitution[code(c1) * SymbolCount + code(c2)]; }
+
+        // Cost of inserting c of s2
+        CostType insertCost(char c) const { return insertion[code(c)]; }
+
+        // Cost of deleting c of s1
+        CostType deleteCost(char c) const { return deletion[code(c)]; }
+
+    private:
+        static IndexType code(char c) { return static_cast<unsigned char>(c); }
+
+        GenericVector<ValueType> substitution; // Row of the character of s1
+        GenericVector<ValueType> insertion;
+        GenericVector<ValueType> deletion;
+    };
+
+    // Weighted edit distance of s1 and s2, equal to approximativeStringMatching(s1, s2, costs)
+    // Striped dynamic programming (Farrar): the shorter string is split into as many interleaved segments as
+    // there are lanes in a vector, so one vector instruction updates a cell of every segment of a column, and
+    // a correction pass carries the deletions across segments. Lanes start at 8-bit saturating values and are
+    // promoted to 16 and 32 bits if the distance may not fit. Costs of the characters of the longer string
+    // are kept as profiles of the shorter one, O(distinct characters * m) memory. simd limits the instruction set.
+    IndexType weightedEditDistance(std::string_view s1, std::string_view s2, const EditCostTable& costs, SimdLevel simd = SimdLevel::AVX2);
+
+}
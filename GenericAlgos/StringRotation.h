@@ -0,0 +1,98 @@
+#pragma once
+
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Rotations and Lyndon factorization of sequences of integer symbols: std::string, std::string_view,
+    // GenericVector<uint32_t> or any other container with size() and operator[]
+    // Symbols are compared as unsigned codes, the same order as in the suffix array. Both routines run
+    // in O(n) time with O(1) working space (Duval) and read the sequence only.
+
+    // Unsigned code of a symbol
+    template <typename Symbol> std::make_unsigned_t<Symbol> symbolCode(Symbol c)
+    {
+        static_assert(std::is_integral<Symbol>::value, "Symbols must be integers");
+        return static_cast<std::make_unsigned_t<Symbol>>(c);
+    }
+
+    // Start of the lexicographically minimal rotation text[start, n) + text[0, start), the smallest one
+    // if several rotations are equal (periodic text). Returns 0 for an empty text.
+    // Duval's factorization of text + text, visited by indexes modulo n without building it: the minimal rotation
+    // starts with the last Lyndon factor starting in the first copy.
+    template <typename Sequence> IndexType minimalRotation(const Sequence& text)
+    {
+        const IndexType n = text.size();
+        auto at = [&text, n](IndexType i) { return symbolCode(text[i < n ? i : i - n]); };
+
+        IndexType start = 0;
+        IndexType i = 0;
+        while (i < n)
+        {
+            start = i;
+
+            // Extend the run of repetitions of the Lyndon word starting at i, its period is j - k
+            IndexType j = i + 1;
+            IndexType k = i;
+            while (j < 2 * n && at(k) <= at(j))
+            {
+                k = (at(k) < at(j)) ? i : k + 1;
+                j++;
+            }
+
+            while (i <= k)
+                i += j - k;
+        }
+
+        return start;
+    }
+
+    // Lyndon factorization (Duval): text is the concatenation of non-increasing Lyndon words,
+    // each strictly smaller than all its proper rotations. Returns start positions of the factors.
+    template <typename Sequence> IndexVct lyndonFactorization(const Sequence& text)
+    {
+        const IndexType n = text.size();
+        auto at = [&text](IndexType i) { return symbolCode(text[i]); };
+
+        IndexVct starts;
+        IndexType i = 0;
+        while (i < n)
+        {
+            IndexType j = i + 1;
+            IndexType k = i;
+            while (j < n && at(k) <= at(j))
+            {
+                k = (at(k) < at(j)) ? i : k + 1;
+                j++;
+            }
+
+            // Repetitions of the word of length j - k are factors
+            for (; i <= k; i += j - k)
+                starts.push_back(i);
+        }
+
+        return starts;
+    }
+
+    // Checks if text is a Lyndon word: non-empty and strictly smaller than all its proper rotations
+    // The first factor of Duval's algorithm has to be the whole text
+    template <typename Sequence> bool isLyndonWord(const Sequence& text)
+    {
+        const IndexType n = text.size();
+        if (n == 0)
+            return false;
+
+        IndexType j = 1;
+        IndexType k = 0;
+        while (j < n && symbolCode(text[k]) <= symbolCode(text[j]))
+        {
+            k = (symbolCode(text[k]) < symbolCode(text[j])) ? 0 : k + 1;
+            j++;
+        }
+        return j == n && k == 0;
+    }
+
+}
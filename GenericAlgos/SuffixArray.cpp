@@ -1,10 +1,15 @@
 ﻿#include <iostream>
+#include <fstream>
+#include <cstring>
 #include <numeric>
 #include <limits>
 #include <stdexcept>
 
 #include "GeneralAlgorithmsAndDataStructures.h"
 #include "SuffixArray.h"
+#include "StringRotation.h"
+#include "SuffixSorting.h"
+#include "ThreadPool.h"
 
 namespace GADS = GeneralAlgorithmsAndDataStructures;
 
@@ -32,23 +37,229 @@ namespace // helpers for buildSuffixMatrix()
         return a.isSmallerOrEqual(b);
     }
 
+    // Index file layout: IndexFileHeader followed by the payload of sections
+    // Section: 64-bit byte size, bytes, zero padding to 8 bytes
+    // Sections: text, suffix array, rank, LCP array, RMQ block minima, RMQ levels
+    // Integers are stored in native byte order, which is verified on loading
+    struct IndexFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t textSize; // Number of symbols
+        uint64_t indexWidth;
+        uint32_t rmqKind;
+        uint32_t sectionCount;
+        uint64_t payloadBytes;
+        uint64_t checksum; // IndexChecksum of the payload
+        uint32_t hasLcp; // Rank, LCP array and RMQ sections are not empty
+        uint32_t symbolWidth; // Bytes per text symbol, 0 in files written before wider symbols stands for 1
+    };
+
+    static_assert(sizeof(IndexFileHeader) == 64, "Index file header must not contain padding");
+
+    constexpr char IndexFileMagic[8] = { 'G', 'A', 'D', 'S', '-', 'S', 'A', '\0' };
+    constexpr uint32_t IndexFileVersion = 1;
+    constexpr uint32_t IndexFileByteOrder = 0x01020304;
+    constexpr GADS::IndexType IndexFileFixedSections = 5; // Sections before the RMQ levels
+
+    constexpr GADS::IndexType paddedSize(GADS::IndexType bytes)
+    {
+        return (bytes + 7) / 8 * 8;
+    }
+
+    // Checksum over 64-bit words, a change of any single word always changes the result
+    class IndexChecksum
+    {
+    public:
+
+        // Add bytes padded with zeros to whole words
+        void update(const void* bytes, GADS::IndexType size)
+        {
+            const uint8_t* data = static_cast<const uint8_t*>(bytes);
+            for (GADS::IndexType pos = 0; pos < size; pos += sizeof(uint64_t))
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, data + pos, std::min<GADS::IndexType>(sizeof(word), size - pos));
+                m_value ^= word * 0x9E3779B97F4A7C15ull;
+                m_value = ((m_value << 29) | (m_value >> 35)) * 0xBF58476D1CE4E5B9ull;
+            }
+        }
+
+        uint64_t value() const { return m_value; }
+
+    private:
+
+        uint64_t m_value = 0x243F6A8885A308D3ull;
+    };
+
+    // Writes sections of an index file, updating its checksum
+    class IndexFileWriter
+    {
+    public:
+
+        explicit IndexFileWriter(std::ofstream& out) : m_out(out) {}
+
+        void writeSection(const void* bytes, GADS::IndexType size)
+        {
+            const uint64_t sectionSize = size;
+            const char padding[8] = {};
+
+            m_out.write(reinterpret_cast<const char*>(&sectionSize), sizeof(sectionSize));
+            m_out.write(static_cast<const char*>(bytes), size);
+            m_out.write(padding, paddedSize(size) - size);
+
+            m_checksum.update(&sectionSize, sizeof(sectionSize));
+            m_checksum.update(bytes, size);
+            m_payloadBytes += sizeof(sectionSize) + paddedSize(size);
+            m_sectionCount++;
+        }
+
+        void writeSection(const GADS::PackedIndexVct& vct)
+        {
+            writeSection(vct.data(), vct.size() * vct.width());
+        }
+
+        uint64_t checksum() const { return m_checksum.value(); }
+        uint64_t payloadBytes() const { return m_payloadBytes; }
+        uint32_t sectionCount() const { return m_sectionCount; }
+
+    private:
+
+        std::ofstream& m_out;
+        IndexChecksum m_checksum;
+        uint64_t m_payloadBytes = 0;
+        uint32_t m_sectionCount = 0;
+    };
+
+    // Reads sections of a mapped index file
+    // Throws std::runtime_error if a section exceeds the payload
+    class IndexFileReader
+    {
+    public:
+
+        IndexFileReader(const uint8_t* payload, GADS::IndexType payloadBytes) : m_pos(payload), m_end(payload + payloadBytes) {}
+
+        // Returns address of the next section and stores its byte size
+        const uint8_t* nextSection(GADS::IndexType& size)
+        {
+            uint64_t sectionSize;
+            if (static_cast<GADS::IndexType>(m_end - m_pos) < sizeof(sectionSize))
+                throw std::runtime_error("Corrupted index file: truncated section");
+            std::memcpy(&sectionSize, m_pos, sizeof(sectionSize));
+            m_pos += sizeof(sectionSize);
+
+            if (sectionSize > static_cast<uint64_t>(m_end - m_pos) || paddedSize(sectionSize) > static_cast<GADS::IndexType>(m_end - m_pos))
+                throw std::runtime_error("Corrupted index file: truncated section");
+
+            const uint8_t* section = m_pos;
+            m_pos += paddedSize(sectionSize);
+            size = static_cast<GADS::IndexType>(sectionSize);
+            return section;
+        }
+
+        // Returns view of the next section holding count indexes of given width
+        GADS::PackedIndexVct nextIndexSection(GADS::IndexType width, GADS::IndexType count)
+        {
+            GADS::IndexType size;
+            const uint8_t* section = nextSection(size);
+            if (size != count * width)
+                throw std::runtime_error("Corrupted index file: unexpected section size");
+            return GADS::PackedIndexVct::view(section, count, width);
+        }
+
+    private:
+
+        const uint8_t* m_pos;
+        const uint8_t* m_end;
+    };
+
+    // Buckets of induced sorting over alphabets up to this size are used directly even for much shorter texts
+    constexpr GADS::IndexType MaxSparseAlphabet = GADS::IndexType(1) << 16;
+
+    // Replaces symbols by ranks of their unsigned codes among the distinct symbols of the text
+    // Sorting over the dense ranks gives the same suffix order in buckets bounded by the text length
+    template <typename Symbol>
+    GADS::GenericVector<uint32_t> renumberSymbols(const Symbol* text, GADS::IndexType n, GADS::IndexType& distinctCount)
+    {
+        using Code = std::make_unsigned_t<Symbol>;
+
+        GADS::GenericVector<Code> distinct(n);
+        for (GADS::IndexType i = 0; i < n; i++)
+            distinct[i] = static_cast<Code>(text[i]);
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        distinctCount = distinct.size();
+
+        GADS::GenericVector<uint32_t> result(n);
+        for (GADS::IndexType i = 0; i < n; i++)
+            result[i] = static_cast<uint32_t>(std::lower_bound(distinct.begin(), distinct.end(), static_cast<Code>(text[i])) - distinct.begin());
+        return result;
+    }
+
+    // Checks if positions up to given text size fit 32-bit working arrays (maximum value is reserved)
+    inline bool fitsUint32(GADS::IndexType n)
+    {
+        return n < std::numeric_limits<uint32_t>::max();
+    }
+
 } // End of anonymous namespace
 
-// Algorithm based on maintaining the order of the string�s suffixes sorted by their 2^k long prefixes
-void GADS::SuffixArray::buildSuffixArray()
+// Builds over text owned by the caller
+template <typename Symbol>
+GADS::BasicSuffixArray<Symbol> GADS::BasicSuffixArray<Symbol>::fromView(TextView text, const SuffixArrayOptions& options)
+{
+    BasicSuffixArray result;
+    result.m_text = text;
+    result.build(options);
+    return result;
+}
+
+// Builds over the mapped file, which is kept alive by the suffix array and its copies
+template <typename Symbol>
+GADS::BasicSuffixArray<Symbol> GADS::BasicSuffixArray<Symbol>::fromTextFile(const std::string& path, const SuffixArrayOptions& options)
+{
+    BasicSuffixArray result;
+    result.m_file = std::make_shared<const MappedFile>(path);
+    if (result.m_file->size() % sizeof(Symbol) != 0)
+        throw std::runtime_error("Size of " + path + " is not a multiple of the symbol size");
+    result.m_text = TextView(static_cast<const Symbol*>(result.m_file->data()), result.m_file->size() / sizeof(Symbol));
+    result.build(options);
+    return result;
+}
+
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::build(const SuffixArrayOptions& options)
+{
+    m_indexWidth = PackedIndexVct::widthBytes(m_text.size(), options.indexWidth);
+
+    if (options.construction == SuffixArrayConstruction::InducedSorting)
+        buildSuffixArrayInducedSorting(options.alphabetSize);
+    else if (options.construction == SuffixArrayConstruction::ParallelPrefixDoubling)
+        buildSuffixArrayParallel(options.threadCount);
+    else
+        buildSuffixArray();
+
+    if (options.lcp != LcpSupport::None)
+        buildLcpSupport(options.lcp == LcpSupport::SparseTable ? RmqKind::SparseTable : RmqKind::BlockSparseTable);
+}
+
+// Algorithm based on maintaining the order of the string's suffixes sorted by their 2^k long prefixes
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::buildSuffixArray()
 {
     const IndexType N = m_text.size(); // Size of input text
 
-    // Add first line containing string characters, with their int code equivalent to order of cnt = 1
-    m_prefixOrderMatrix.emplace_back(IndexVct(N));
-    std::copy(std::begin(m_text), std::end(m_text), std::begin(m_prefixOrderMatrix.back()));
+    // Order of prefixes of length 1 given by unsigned symbol codes, shifted to keep 0 for the end of text
+    IndexVct lastOrder(N);
+    std::transform(std::begin(m_text), std::end(m_text), std::begin(lastOrder),
+        [](Symbol c) { return static_cast<IndexType>(static_cast<std::make_unsigned_t<Symbol>>(c)) + 1; });
+    IndexVct newOrder(N);
 
     GenericVector<SortEntry> prefixes(N); // Helper vector for sorting prefixes
 
     for (IndexType cnt = 1; cnt < N; cnt <<= 1) // Performing log ceil(N) steps to sort prefixes of size up to N (longest suffix)
     {
-        const IndexVct& lastOrder = m_prefixOrderMatrix.back();
-
         // Setting up data for sorting, building prefixes of size cnt * 2 by composing 2 prefixes of size cnt
         for (IndexType i = 0; i < N; i++)
         {
@@ -57,17 +268,13 @@ void GADS::SuffixArray::buildSuffixArray()
             if (i + cnt < N)
                 prefixes[i].chunk[1] = lastOrder[i + cnt]; // Second chunk of the prefix
             else
-                prefixes[i].chunk[1] = 0; // End of prefix out of range, use null character, lexicographically before all other ones
+                prefixes[i].chunk[1] = 0; // End of prefix out of range, lexicographically before all symbols
 
             prefixes[i].pos = i; // Original prefix position before sorting 
         }
 
         quickSortInPlace(prefixes);
 
-        m_prefixOrderMatrix.emplace_back(IndexVct(N)); // Add another line to matrix filled with sorted prefixes
-        GADS::IndexVct& newOrder = m_prefixOrderMatrix.back();
-
-        // Setting new line of sequences of length 2^k
         // Assign sorted order of prefixes 2^k to related suffixes 
         for (IndexType i = 0; i < N; i++)
         {
@@ -78,18 +285,221 @@ void GADS::SuffixArray::buildSuffixArray()
                 )
                 newOrder[prefixes[i].pos] = newOrder[prefixes[i - 1].pos];
             else
-                newOrder[prefixes[i].pos] = i;
+                newOrder[prefixes[i].pos] = i + 1; // Order 0 is reserved for the end of text
         }
 
+        lastOrder.swap(newOrder);
     }
 
     // Fill array of starting indexes of suffixes in lexicographically sorted order.
+    m_suffixArray = PackedIndexVct(N, m_indexWidth);
+    for (IndexType i = 0; i < N; i++)
+        m_suffixArray.set(i, prefixes[i].pos);
+}
+
+// Linear time construction by induced sorting of symbols taken as unsigned codes
+// Without a given alphabet size 8 and 16-bit symbols use buckets for all their codes, wider ones up to the largest code
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::buildSuffixArrayInducedSorting(IndexType alphabetSize)
+{
+    using Code = std::make_unsigned_t<Symbol>;
+    constexpr IndexType CodeCount = IndexType(std::numeric_limits<Code>::max()) + 1;
+    constexpr bool WideSymbols = sizeof(Symbol) > sizeof(uint16_t);
+
+    const IndexType N = m_text.size();
+
+    if (alphabetSize != 0 || WideSymbols)
+    {
+        IndexType largest = 0;
+        for (auto c : m_text)
+            largest = std::max<IndexType>(largest, static_cast<Code>(c));
+
+        if (alphabetSize != 0 && N > 0 && largest >= alphabetSize)
+            throw std::invalid_argument("Symbol " + std::to_string(largest) + " exceeds alphabet size " + std::to_string(alphabetSize));
+        if (alphabetSize == 0)
+            alphabetSize = largest + 1;
+    }
+    alphabetSize = std::min(alphabetSize == 0 ? CodeCount : alphabetSize, CodeCount);
+
+    // Working arrays use 32-bit indexes whenever possible
+    auto sortSuffixes = [N, this](const auto* text, IndexType alphabet)
+    {
+        if (fitsUint32(N))
+            return PackedIndexVct(induceSortSuffixes<uint32_t>(text, N, alphabet), m_indexWidth);
+        return PackedIndexVct(induceSortSuffixes<uint64_t>(text, N, alphabet), m_indexWidth);
+    };
+
+    if (alphabetSize <= std::max(2 * N, MaxSparseAlphabet))
+    {
+        m_suffixArray = sortSuffixes(m_text.data(), alphabetSize);
+    }
+    else
+    {
+        IndexType distinctCount;
+        const GenericVector<uint32_t> renumbered = renumberSymbols(m_text.data(), N, distinctCount);
+        m_suffixArray = sortSuffixes(renumbered.data(), distinctCount);
+    }
+}
+
+// Prefix doubling on a pool of its own, the result is the same as of the sequential algorithms
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::buildSuffixArrayParallel(IndexType threadCount)
+{
+    ThreadPool pool(threadCount);
+
+    if (fitsUint32(m_text.size()))
+        m_suffixArray = PackedIndexVct(parallelSortSuffixes<uint32_t>(m_text.data(), m_text.size(), pool), m_indexWidth);
+    else
+        m_suffixArray = PackedIndexVct(parallelSortSuffixes<uint64_t>(m_text.data(), m_text.size(), pool), m_indexWidth);
+}
+
+// Kasai LCP array with range minimum queries, lcp of any two suffixes is the minimum over LCP between their orders
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::buildLcpSupport(RmqKind rmqKind)
+{
+    const IndexType N = m_text.size();
+
+    m_rank = PackedIndexVct(N, m_indexWidth);
     for (IndexType i = 0; i < N; i++)
-        m_suffixArray[i] = prefixes[i].pos;
+        m_rank.set(m_suffixArray[i], i);
+
+    if (fitsUint32(N))
+        m_lcpArray = PackedIndexVct(buildLcpArray<uint32_t>(m_text.data(), N, m_suffixArray, m_rank), m_indexWidth);
+    else
+        m_lcpArray = PackedIndexVct(buildLcpArray<uint64_t>(m_text.data(), N, m_suffixArray, m_rank), m_indexWidth);
+
+    m_lcpRmq = RangeMinimumQuery(m_lcpArray, rmqKind, m_indexWidth);
+}
+
+// Saves header with a placeholder checksum, writes the sections and completes the header
+template <typename Symbol>
+void GADS::BasicSuffixArray<Symbol>::save(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Cannot create index file " + path);
+
+    IndexFileHeader header = {};
+    std::memcpy(header.magic, IndexFileMagic, sizeof(header.magic));
+    header.version = IndexFileVersion;
+    header.byteOrder = IndexFileByteOrder;
+    header.textSize = m_text.size();
+    header.symbolWidth = sizeof(Symbol);
+    header.indexWidth = m_indexWidth;
+    header.rmqKind = static_cast<uint32_t>(m_lcpRmq.kind());
+    header.hasLcp = !m_lcpArray.empty();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    IndexFileWriter writer(out);
+    writer.writeSection(m_text.data(), m_text.size() * sizeof(Symbol));
+    writer.writeSection(m_suffixArray);
+    writer.writeSection(m_rank);
+    writer.writeSection(m_lcpArray);
+    writer.writeSection(m_lcpRmq.blockMinimum());
+    for (const auto& level : m_lcpRmq.levels())
+        writer.writeSection(level);
+
+    header.sectionCount = writer.sectionCount();
+    header.payloadBytes = writer.payloadBytes();
+    header.checksum = writer.checksum();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    out.close();
+    if (!out)
+        throw std::runtime_error("Cannot write index file " + path);
+}
+
+// Validates the header and section sizes and views the sections in the mapped file without copying
+template <typename Symbol>
+GADS::BasicSuffixArray<Symbol> GADS::BasicSuffixArray<Symbol>::load(const std::string& path, bool verifyChecksum)
+{
+    auto file = std::make_shared<const MappedFile>(path);
+    const uint8_t* fileData = static_cast<const uint8_t*>(file->data());
+
+    IndexFileHeader header;
+    if (file->size() < sizeof(header))
+        throw std::runtime_error("Not an index file: " + path);
+    std::memcpy(&header, fileData, sizeof(header));
+
+    if (std::memcmp(header.magic, IndexFileMagic, sizeof(header.magic)) != 0)
+        throw std::runtime_error("Not an index file: " + path);
+    if (header.version != IndexFileVersion)
+        throw std::runtime_error("Unsupported index file version " + std::to_string(header.version));
+    if (header.byteOrder != IndexFileByteOrder)
+        throw std::runtime_error("Index file has different byte order");
+    if (header.payloadBytes != file->size() - sizeof(header))
+        throw std::runtime_error("Corrupted index file: unexpected file size");
+    if (std::max<uint32_t>(header.symbolWidth, 1) != sizeof(Symbol))
+        throw std::runtime_error("Index file has different symbol size");
+    if (header.indexWidth != 4 && header.indexWidth != 5 && header.indexWidth != 8)
+        throw std::runtime_error("Corrupted index file: invalid index width");
+    if (header.rmqKind > static_cast<uint32_t>(RmqKind::BlockSparseTable) || header.hasLcp > 1 || header.sectionCount < IndexFileFixedSections)
+        throw std::runtime_error("Corrupted index file: invalid header");
+
+    const uint8_t* payload = fileData + sizeof(header);
+    if (verifyChecksum)
+    {
+        IndexChecksum checksum;
+        checksum.update(payload, header.payloadBytes);
+        if (checksum.value() != header.checksum)
+            throw std::runtime_error("Corrupted index file: checksum mismatch");
+    }
+
+    BasicSuffixArray result;
+    result.m_file = file;
+    result.m_indexWidth = header.indexWidth;
+
+    IndexFileReader reader(payload, header.payloadBytes);
+
+    IndexType textBytes;
+    const uint8_t* text = reader.nextSection(textBytes);
+    if (textBytes / sizeof(Symbol) != header.textSize || textBytes % sizeof(Symbol) != 0)
+        throw std::runtime_error("Corrupted index file: unexpected section size");
+
+    // Sections start at multiples of 8 bytes of the mapped file, so symbols are aligned
+    const IndexType N = header.textSize;
+    result.m_text = TextView(reinterpret_cast<const Symbol*>(text), N);
+
+    const IndexType width = result.m_indexWidth;
+    result.m_suffixArray = reader.nextIndexSection(width, N);
+
+    // Rank, LCP and RMQ tables are present only with lcp support
+    const IndexType lcpCount = header.hasLcp ? N : 0;
+    result.m_rank = reader.nextIndexSection(width, lcpCount);
+    result.m_lcpArray = reader.nextIndexSection(width, lcpCount);
+
+    const RmqKind rmqKind = static_cast<RmqKind>(header.rmqKind);
+    const IndexType blockCount = (rmqKind == RmqKind::BlockSparseTable) ? (lcpCount + RangeMinimumQuery::BlockSize - 1) / RangeMinimumQuery::BlockSize : 0;
+    PackedIndexVct blockMinimum = reader.nextIndexSection(width, blockCount);
+
+    // Level k - 1 holds base - 2^k + 1 entries
+    const IndexType base = (rmqKind == RmqKind::BlockSparseTable) ? blockCount : lcpCount;
+    GenericVector<PackedIndexVct> levels;
+    for (IndexType k = 1; k <= header.sectionCount - IndexFileFixedSections; k++)
+    {
+        if ((IndexType(1) << k) > base)
+            throw std::runtime_error("Corrupted index file: unexpected section count");
+        levels.emplace_back(reader.nextIndexSection(width, base - (IndexType(1) << k) + 1));
+    }
+    if (base > 1 && (IndexType(1) << (levels.size() + 1)) <= base)
+        throw std::runtime_error("Corrupted index file: unexpected section count");
+
+    result.m_lcpRmq = RangeMinimumQuery(rmqKind, width, std::move(blockMinimum), std::move(levels));
+
+    return result;
+}
+
+// Size of the text and index structures in bytes
+template <typename Symbol>
+GADS::IndexType GADS::BasicSuffixArray<Symbol>::memoryUsage() const
+{
+    return m_text.size() * sizeof(Symbol) + m_suffixArray.memoryUsage() + m_rank.memoryUsage() + m_lcpArray.memoryUsage() + m_lcpRmq.memoryUsage();
 }
 
 // Finds length of longest common prefix
-GADS::IndexType GADS::SuffixArray::lcp(IndexType x, IndexType y) const
+template <typename Symbol>
+GADS::IndexType GADS::BasicSuffixArray<Symbol>::lcp(IndexType x, IndexType y) const
 {
     const IndexType N = m_text.size(); // Size of input text
 
@@ -98,102 +508,309 @@ GADS::IndexType GADS::SuffixArray::lcp(IndexType x, IndexType y) const
 
     if (x == y) return N - x;
 
-    IndexType len = 0;
-
-    for (IndexType k = m_prefixOrderMatrix.size() - 1; k >= 0 && x < N && y < N; k--)
+    if (m_lcpArray.empty()) // No lcp support, compare characters
     {
-        if (m_prefixOrderMatrix[k][x] == m_prefixOrderMatrix[k][y])
-        { // Match found for a sequence 2^k, check also possible tails of len 2^k-1, 2^k-2 etc.
-            IndexType foundPartLen = 1llu << k;
-            x += foundPartLen;
-            y += foundPartLen;
-            len += foundPartLen;
-        }
-
-        if (k == 0) // Do not decrement unsigned k in loop
-            break;
+        IndexType len = 0;
+        while (x + len < N && y + len < N && m_text[x + len] == m_text[y + len])
+            len++;
+        return len;
     }
-    return len;
+
+    IndexType rankX = m_rank[x];
+    IndexType rankY = m_rank[y];
+    if (rankX > rankY)
+        std::swap(rankX, rankY);
+
+    return m_lcpRmq.minimum(m_lcpArray, rankX + 1, rankY);
 }
 
-// Checks if text contains a substring in time log size(text) * size(subsr)
-GADS::IndexType GADS::SuffixArray::searchSubstring(const std::string& substr) const
+// Lower bound of the pattern followed by a check of the found suffix
+template <typename Symbol>
+GADS::IndexType GADS::BasicSuffixArray<Symbol>::searchSubstring(TextView substr) const
 {
     if (substr.size() == 0)
         throw std::out_of_range("Substring is empty");
 
+    const IndexType order = findBound(substr, false, 0, m_suffixArray.size());
+    if (order < m_suffixArray.size() && m_text.substr(m_suffixArray[order], substr.size()) == substr)
+        return order;
+
+    return m_suffixArray.size(); // Not found
+}
+
+// Suffixes starting with pattern lie between its lower and upper bound
+template <typename Symbol>
+std::pair<GADS::IndexType, GADS::IndexType> GADS::BasicSuffixArray<Symbol>::findRange(TextView pattern, IndexType* comparedSymbols) const
+{
+    const IndexType lo = findBound(pattern, false, 0, m_suffixArray.size(), comparedSymbols);
+    return { lo, findBound(pattern, true, lo, m_suffixArray.size(), comparedSymbols) };
+}
+
+// Lower bounds of sorted patterns do not decrease, so every search window starts at the previous lower bound
+// and consecutive searches follow similar paths through the suffix array
+template <typename Symbol>
+GADS::GenericVector< std::pair<GADS::IndexType, GADS::IndexType> >
+GADS::BasicSuffixArray<Symbol>::findRanges(const GenericVector<TextView>& patterns, ThreadPool* pool) const
+{
+    const IndexType N = m_suffixArray.size();
 
-    IndexType res = GADS::binSearch(m_suffixArray, substr,
-        0, m_suffixArray.size() - 1,
-        [this](IndexType idx, const std::string& substr)
+    IndexVct order(patterns.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&patterns](IndexType a, IndexType b)
         {
-            return this->isLexEqual(idx, substr);
-        },
-        [this](IndexType idx, const std::string& substr)
+            // Unsigned symbol order like in the suffix order
+            return std::lexicographical_compare(patterns[a].begin(), patterns[a].end(), patterns[b].begin(), patterns[b].end(),
+                [](Symbol x, Symbol y) { return static_cast<std::make_unsigned_t<Symbol>>(x) < static_cast<std::make_unsigned_t<Symbol>>(y); });
+        });
+
+    GenericVector< std::pair<IndexType, IndexType> > ranges(patterns.size());
+
+    auto searchSorted = [&](IndexType beg, IndexType end)
+    {
+        std::pair<IndexType, IndexType> range(0, N);
+        for (IndexType i = beg; i < end; i++)
         {
-            return this->isLexSmaller(idx, substr);
+            const TextView pattern = patterns[order[i]];
+
+            // Extensions of the previous pattern (including equal patterns) lie within its range
+            IndexType right = N;
+            if (i > beg)
+            {
+                const TextView previous = patterns[order[i - 1]];
+                if (pattern == previous)
+                {
+                    ranges[order[i]] = range;
+                    continue;
+                }
+                if (pattern.substr(0, previous.size()) == previous)
+                    right = range.second;
+            }
+
+            range.first = findBound(pattern, false, range.first, right);
+            range.second = findBound(pattern, true, range.first, right);
+            ranges[order[i]] = range;
         }
-        );
+    };
 
-    return res;
+    // Parts of the batch big enough to share search paths, a few per thread for load balancing
+    constexpr IndexType MinPartSize = 64;
+    if (pool != nullptr && patterns.size() >= 2 * MinPartSize)
+        pool->parallelFor(patterns.size(), std::min(4 * pool->size(), patterns.size() / MinPartSize), searchSorted);
+    else
+        searchSorted(0, patterns.size());
+
+    return ranges;
 }
 
-// Helper checks if a prefix of the suffix starting from index idx is equal to given substring 
-// Result = 0 substr is contained
-// Result = 1 suffix is lexicographically smaller
-// Result = 2 suffix is lexicographically bigger
-GADS::SuffixArray::CompareResult
-GADS::SuffixArray::compareSubstring(IndexType idx, const std::string& substr) const
+// Binary search keeping lengths l and r of matches of the pattern with suffixes bordering the searched window
+// Middle suffix matches at least min(l, r) characters. With lcp support, when l and r differ by more than the cost
+// of a range minimum query, the lcp of the middle suffix with the border of longer match decides the step
+// without comparing characters unless it equals that match.
+// Symbols are compared as unsigned codes like in the suffix order.
+template <typename Symbol>
+GADS::IndexType GADS::BasicSuffixArray<Symbol>::findBound(TextView pattern, bool upper, IndexType left, IndexType right,
+    IndexType* comparedSymbols) const
 {
-    if (idx >= outOfRangeVal())
-        throw std::out_of_range("Input data out of range");
+    const IndexType N = m_suffixArray.size();
+    const IndexType M = pattern.size();
+    const bool lcpSupport = !m_lcpArray.empty();
+    constexpr IndexType LcpSkipMin = RangeMinimumQuery::BlockSize; // Shorter skips are cheaper by comparing characters
 
-    if (substr.size() == 0)
-        throw std::out_of_range("Substring is empty");
-
-    IndexType len = std::min(m_text.size() - idx, substr.size());
+    auto code = [](Symbol c) { return static_cast<std::make_unsigned_t<Symbol>>(c); };
 
-    CompareResult result = CompareResult::Undefined; // Initial substrings of len 0, result is match
+    // Bound lies in [left, right], suffix left - 1 precedes it, suffix right does not
+    // Initial matches are underestimated by 0, which only delays lcp skipping until they are known exactly
+    IndexType l = 0; // Match of the pattern with suffix left - 1
+    IndexType r = 0; // Match of the pattern with suffix right
+    IndexType compared = 0;
 
-    // Verify every character in substring
-    for (IndexType i = 0; i < len; i++)
+    while (left < right)
     {
-        if (m_text[idx + i] != substr[i])
+        const IndexType mid = left + (right - left) / 2;
+
+        bool precedes = false; // Suffix mid precedes the bound
+        bool decided = false;
+        IndexType match = std::min(l, r); // Match of the pattern with suffix mid
+
+        if (lcpSupport && l >= r + LcpSkipMin)
         {
-            if (m_text[idx + i] < substr[i])
-                result = CompareResult::Smaller;
+            const IndexType lm = std::min(lcpOfOrders(left - 1, mid), M);
+            if (lm != l)
+            {
+                precedes = (lm > l); // Mid shares the mismatch of suffix left - 1 with the pattern or differs earlier
+                match = std::min(lm, l);
+                decided = true;
+            }
             else
-                result = CompareResult::Bigger;
-            break;
+                match = l; // Mid matches the pattern at least as far as suffix left - 1
+        }
+        else if (lcpSupport && r >= l + LcpSkipMin)
+        {
+            const IndexType rm = std::min(lcpOfOrders(mid, right), M);
+            if (rm != r)
+            {
+                precedes = (rm < r);
+                match = std::min(rm, r);
+                decided = true;
+            }
+            else
+                match = r;
+        }
+
+        if (!decided)
+        {
+            const IndexType pos = m_suffixArray[mid];
+            const IndexType known = match;
+            while (match < M && pos + match < N && m_text[pos + match] == pattern[match])
+                match++;
+            compared += match - known + (match < M && pos + match < N);
+
+            if (match == M)
+                precedes = upper; // Suffix starts with pattern
+            else
+                precedes = (pos + match == N) || (code(m_text[pos + match]) < code(pattern[match]));
+        }
+
+        if (precedes)
+        {
+            left = mid + 1;
+            l = match;
+        }
+        else
+        {
+            right = mid;
+            r = match;
         }
     }
 
-    if (result == CompareResult::Undefined) // Substring is matching suffix of size len
+    if (comparedSymbols != nullptr)
+        *comparedSymbols += compared;
+    return left;
+}
+
+template <typename Symbol>
+GADS::IndexVct GADS::BasicSuffixArray<Symbol>::lcpArrayForScan() const
+{
+    if (!m_lcpArray.empty())
+        return m_lcpArray.toVector();
+
+    const IndexType N = m_text.size();
+    IndexVct rank(N);
+    for (IndexType order = 0; order < N; order++)
+        rank[m_suffixArray[order]] = order;
+    return buildLcpArray<IndexType>(m_text.data(), N, m_suffixArray, rank);
+}
+
+// The longest repeat is the longest common prefix of some neighbouring suffixes, its range extends over
+// the following neighbours sharing it
+template <typename Symbol>
+GADS::Repeat GADS::BasicSuffixArray<Symbol>::longestRepeatedSubstring() const
+{
+    const IndexVct lcp = lcpArrayForScan();
+
+    IndexType best = 0;
+    for (IndexType i = 1; i < lcp.size(); i++)
     {
-        if (m_text.size() - idx < substr.size()) // Suffix too short to contain entire substr
-            result = CompareResult::Smaller;
-        else
-            result = CompareResult::Equal; // substr is prefix of given suffix
+        if (lcp[i] > lcp[best])
+            best = i;
     }
+    if (best == 0 || lcp[best] == 0)
+        return { 0, 0, 0 };
 
-    return result;
+    IndexType hi = best + 1;
+    while (hi < lcp.size() && lcp[hi] == lcp[best])
+        hi++;
+    return { lcp[best], best - 1, hi };
 }
 
-// Returns minimal lexicographic rotation of the initial text
-std::string GADS::SuffixArray::minLexRotation() const
+// Right maximal repeats are lcp-intervals: ranges of suffixes sharing a prefix not shared by their neighbours.
+// An interval is left maximal if its suffixes are preceded by different symbols or one starts the text.
+// Intervals are closed with a stack of the open ones by increasing lcp, a closed interval passes
+// its preceding symbols to the enclosing one.
+template <typename Symbol>
+GADS::GenericVector<GADS::Repeat> GADS::BasicSuffixArray<Symbol>::maximalRepeats(IndexType minLength) const
 {
-    // Get the lexicographically smallest suffix idx
-    const GADS::IndexType minLexSuffixIdx = m_suffixArray[0];
+    const IndexType N = m_text.size();
+    minLength = std::max<IndexType>(minLength, 1);
+
+    constexpr int64_t NoSymbol = -1; // No suffix seen yet
+    constexpr int64_t Diverse = -2; // Different preceding symbols or the text start
 
-    // Get the lexicographically smallest suffix
-    std::string rotation = m_text.substr(minLexSuffixIdx);
+    auto preceding = [this](IndexType order) -> int64_t
+    {
+        const IndexType pos = m_suffixArray[order];
+        return (pos == 0) ? Diverse : static_cast<int64_t>(static_cast<std::make_unsigned_t<Symbol>>(m_text[pos - 1]));
+    };
+    auto combine = [](int64_t a, int64_t b)
+    {
+        if (a == NoSymbol || a == b)
+            return b;
+        return (b == NoSymbol) ? a : Diverse;
+    };
+
+    struct OpenInterval
+    {
+        IndexType lcp;
+        IndexType lo;
+        int64_t left; // Common symbol preceding the suffixes of the interval, NoSymbol or Diverse
+    };
+
+    GenericVector<Repeat> result;
+    if (N == 0)
+        return result;
+
+    const IndexVct lcp = lcpArrayForScan();
 
-    // Complete it with its prefix if needed
-    if (m_suffixArray[0] > 0)
+    GenericVector<OpenInterval> open = { { 0, 0, preceding(0) } };
+    for (IndexType i = 1; i <= N; i++)
     {
-        rotation += m_text.substr(0, minLexSuffixIdx);
+        const IndexType h = (i < N) ? lcp[i] : 0;
+        IndexType lo = i - 1;
+        int64_t left = preceding(i - 1);
+
+        while (h < open.back().lcp)
+        {
+            const OpenInterval closed = open.back();
+            open.pop_back();
+            if (closed.lcp >= minLength && closed.left == Diverse)
+                result.push_back({ closed.lcp, closed.lo, i });
+
+            open.back().left = combine(open.back().left, closed.left);
+            lo = closed.lo;
+            left = closed.left;
+        }
+
+        if (h > open.back().lcp)
+            open.push_back({ h, lo, left });
+        if (i < N)
+            open.back().left = combine(open.back().left, preceding(i));
     }
 
+    return result;
+}
+
+// Returns minimal lexicographic rotation of the initial text
+template <typename Symbol>
+typename GADS::BasicSuffixArray<Symbol>::Text GADS::BasicSuffixArray<Symbol>::minLexRotation() const
+{
+    const IndexType start = minLexRotationStart();
+
+    Text rotation;
+    rotation.reserve(m_text.size());
+    rotation += m_text.substr(start);
+    rotation += m_text.substr(0, start);
+
     return rotation;
 }
 
+// Duval's algorithm on the text, the suffix order alone does not determine the rotation order
+template <typename Symbol>
+GADS::IndexType GADS::BasicSuffixArray<Symbol>::minLexRotationStart() const
+{
+    return minimalRotation(m_text);
+}
+
+template class GADS::BasicSuffixArray<char>;
+template class GADS::BasicSuffixArray<uint8_t>;
+template class GADS::BasicSuffixArray<uint16_t>;
+template class GADS::BasicSuffixArray<uint32_t>;
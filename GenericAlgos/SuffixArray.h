@@ -1,36 +1,190 @@
 #pragma once
 
+#include <iterator>
+#include <string_view>
+
 #include "GeneralAlgorithmsAndDataStructures.h"
+#include "MappedFile.h"
+#include "PackedIndexVector.h"
+#include "RangeMinimumQuery.h"
+#include "SymbolString.h"
 
 namespace GeneralAlgorithmsAndDataStructures
 {
 
-    // Builds suffix array for given text
-    class SuffixArray
+    class ThreadPool;
+
+    // Suffix array construction algorithms
+    enum class SuffixArrayConstruction
+    {
+        PrefixDoubling, // O(n log^2 n)
+        InducedSorting, // SA-IS in O(n)
+        ParallelPrefixDoubling // O(n log n) work with parallel radix sorts over SuffixArrayOptions::threadCount threads
+    };
+
+    // Support for lcp() queries
+    enum class LcpSupport
+    {
+        None, // No auxiliary data, lcp() compares characters in O(n)
+        SparseTable, // LCP array with sparse table, O(1) lcp() with n log n entries
+        BlockSparseTable // LCP array with blocked sparse table, O(1) lcp() scanning at most 2 blocks
+    };
+
+    // Options of suffix array construction
+    struct SuffixArrayOptions
+    {
+        SuffixArrayOptions(SuffixArrayConstruction constructionAlgorithm = SuffixArrayConstruction::InducedSorting,
+            LcpSupport lcpSupport = LcpSupport::BlockSparseTable, IndexWidth width = IndexWidth::Auto, IndexType threads = 0,
+            IndexType alphabet = 0)
+            : construction(constructionAlgorithm), lcp(lcpSupport), indexWidth(width), threadCount(threads), alphabetSize(alphabet) {}
+
+        SuffixArrayConstruction construction;
+        LcpSupport lcp;
+        IndexWidth indexWidth; // Width of stored indexes, Auto selects 32, 40 or 64 bits from the text length
+        IndexType threadCount; // Threads of parallel construction, 0 selects the number of hardware threads
+
+        // Bound of unsigned symbol codes for induced sorting, 0 derives it from the symbol type or the text
+        // Texts of 32-bit symbols with a bound over the text length are sorted after renumbering their distinct symbols
+        IndexType alphabetSize;
+    };
+
+    // Substring occurring at least twice: its length and range [lo, hi) of orders of the suffixes starting with it
+    struct Repeat
+    {
+        IndexType length;
+        IndexType lo;
+        IndexType hi;
+
+        // Number of occurrences
+        IndexType count() const { return hi - lo; }
+
+        bool operator == (const Repeat& other) const { return length == other.length && lo == other.lo && hi == other.hi; }
+    };
+
+    // Builds suffix array for given text of integer symbols: char, uint8_t, uint16_t or uint32_t
+    // Symbols are ordered as unsigned codes, every code including 0 is a regular symbol
+    // and a suffix is smaller than all suffixes it is a proper prefix of
+    template <typename Symbol> class BasicSuffixArray
     {
     public:
-        // Create suffix array from given text
-        SuffixArray(std::string text) : m_text(std::move(text)), m_suffixArray(m_text.size())
+
+        static_assert(std::is_integral<Symbol>::value && sizeof(Symbol) <= sizeof(uint32_t), "Symbols must be integers up to 32 bits");
+
+        using Text = BasicSymbolString<Symbol>;
+        using TextView = BasicSymbolView<Symbol>;
+
+        // Lazy sequence of text positions of suffixes in a range of suffix array orders, in lexicographic order of the suffixes
+        // Valid as long as the suffix array it was taken from
+        class Occurrences
         {
-            buildSuffixArray();
+        public:
+
+            class const_iterator
+            {
+            public:
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = IndexType;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const IndexType*;
+                using reference = IndexType;
+
+                const_iterator(const PackedIndexVct* suffixArray, IndexType order) : m_suffixArray(suffixArray), m_order(order) {}
+
+                IndexType operator*() const { return (*m_suffixArray)[m_order]; }
+
+                const_iterator& operator++()
+                {
+                    m_order++;
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator prev = *this;
+                    m_order++;
+                    return prev;
+                }
+
+                bool operator == (const const_iterator& other) const { return m_order == other.m_order; }
+                bool operator != (const const_iterator& other) const { return m_order != other.m_order; }
+
+            private:
+
+                const PackedIndexVct* m_suffixArray;
+                IndexType m_order;
+            };
+
+            Occurrences(const PackedIndexVct& suffixArray, IndexType beg, IndexType end) : m_suffixArray(&suffixArray), m_beg(beg), m_end(end) {}
+
+            const_iterator begin() const { return const_iterator(m_suffixArray, m_beg); }
+            const_iterator end() const { return const_iterator(m_suffixArray, m_end); }
+
+            IndexType size() const { return m_end - m_beg; }
+            bool empty() const { return m_beg == m_end; }
+
+        private:
+
+            const PackedIndexVct* m_suffixArray;
+            IndexType m_beg;
+            IndexType m_end;
+        };
+
+        // Create suffix array from given text, the text is moved in without copying
+        // Throws std::invalid_argument if requested index width is too small for the text
+        // or a symbol is not smaller than the requested alphabet size
+        BasicSuffixArray(Text text, const SuffixArrayOptions& options = SuffixArrayOptions())
+            : m_ownedText(std::make_shared<const Text>(std::move(text))), m_text(*m_ownedText)
+        {
+            build(options);
         }
 
+        // Create suffix array over text owned by the caller, which has to outlive the suffix array and its copies
+        // Throws std::invalid_argument if requested index width is too small for the text
+        static BasicSuffixArray fromView(TextView text, const SuffixArrayOptions& options = SuffixArrayOptions());
+
+        // Create suffix array over the content of a text file mapped into memory, symbols in native byte order
+        // Throws std::runtime_error if the file cannot be mapped or its size is not a multiple of the symbol size,
+        // std::invalid_argument as the constructor
+        static BasicSuffixArray fromTextFile(const std::string& path, const SuffixArrayOptions& options = SuffixArrayOptions());
+
+        // Save text, suffix array and lcp support to a versioned, checksummed binary file
+        // Throws std::runtime_error if the file cannot be written
+        void save(const std::string& path) const;
+
+        // Load suffix array saved by save() by memory mapping the file, queries run directly on the mapped pages
+        // Checksum verification reads the whole file, without it loading takes constant time
+        // Throws std::runtime_error if the file cannot be mapped, has a different format or symbol size or is corrupted
+        static BasicSuffixArray load(const std::string& path, bool verifyChecksum = false);
+
         // Receive input text
-        const std::string& getInputText() const
+        TextView getInputText() const
         {
             return m_text;
         }
 
-        // Receive result
-        const IndexVct& get() const&
+        // Receive unpacked copy of result
+        IndexVct get() const
         {
-            return m_suffixArray;
+            return m_suffixArray.toVector();
         }
 
-        // Receive copy (possibly rvalue) of result
-        IndexVct&& get() &&
+        // Number of suffixes
+        IndexType size() const
         {
-            return std::move(m_suffixArray);
+            return m_suffixArray.size();
+        }
+
+        // Position in the text of the suffix of given 0-based lexicographic order
+        IndexType getPosition(IndexType order) const
+        {
+            return m_suffixArray[order];
+        }
+
+        // Bytes used to store every index
+        IndexType getIndexWidth() const
+        {
+            return m_indexWidth;
         }
 
         // Verifies if given index is valid inside of the suffix array
@@ -42,54 +196,130 @@ namespace GeneralAlgorithmsAndDataStructures
 
         // Algorithms
         
-        // Get 1-based n-th suffix in lexicographic order
+        // Get 1-based n-th suffix in lexicographic order, the view refers to the text of the suffix array
         // Throws std::out_of_range if n is not valid
-        std::string getNthSuffix(IndexType n) const
+        TextView getNthSuffix(IndexType n) const
         {
             return m_text.substr(m_suffixArray.at(n - 1));
         }
 
 
-        // Finds length of longest common prefix of given suffixes in O(log n) time
+        // LCP array: lcp of suffixes of order i - 1 and i at position i, empty without lcp support
+        IndexVct getLcpArray() const
+        {
+            return m_lcpArray.toVector();
+        }
+
+        // Size of the text and index structures in bytes
+        IndexType memoryUsage() const;
+
+
+        // Finds length of longest common prefix of suffixes starting at given positions
+        // in O(1) time with lcp support or by comparing characters without it
         IndexType lcp(IndexType x, IndexType y) const;
 
-        // Checks if text contains a substring in time O(log (size(text)) * size(subsr) )
-        IndexType searchSubstring(const std::string& substr) const;
+        // Checks if text contains a substring, returns order of the first suffix starting with it or size() if not found
+        // Throws std::out_of_range if substr is empty
+        IndexType searchSubstring(TextView substr) const;
+
+        // Range [lo, hi) of orders of suffixes starting with pattern, empty range positioned where pattern would be
+        // O(m + log n) with lcp support (Manber-Myers), otherwise comparisons skip the prefix matched by both borders
+        // comparedSymbols, if given, is increased by the number of text symbols compared with the pattern
+        std::pair<IndexType, IndexType> findRange(TextView pattern, IndexType* comparedSymbols = nullptr) const;
+
+        // Ranges of suffix orders starting with every pattern, same as findRange() for each of them
+        // Patterns are searched in sorted order, every search starting from the lower bound of the previous pattern.
+        // With a thread pool contiguous parts of the sorted batch are searched in parallel.
+        GenericVector< std::pair<IndexType, IndexType> > findRanges(const GenericVector<TextView>& patterns, ThreadPool* pool = nullptr) const;
+
+        // Number of occurrences of pattern in the text
+        IndexType count(TextView pattern) const
+        {
+            const auto range = findRange(pattern);
+            return range.second - range.first;
+        }
+
+        // Text positions of all occurrences of pattern, computed lazily while iterating
+        Occurrences occurrences(TextView pattern) const
+        {
+            const auto range = findRange(pattern);
+            return Occurrences(m_suffixArray, range.first, range.second);
+        }
+
+        // Text positions of all occurrences of a repeat found by the suffix array, computed lazily while iterating
+        Occurrences occurrences(const Repeat& repeat) const
+        {
+            return Occurrences(m_suffixArray, repeat.lo, repeat.hi);
+        }
+
+        // Longest substring occurring at least twice, the lexicographically smallest if there are several
+        // Length is 0 and the range empty if no symbol repeats. O(n) with lcp support, otherwise the LCP array is built first.
+        Repeat longestRepeatedSubstring() const;
 
-        // Returns minimal lexicographic rotation of the initial text in O(1) time
-        std::string minLexRotation() const;
+        // All maximal repeats of at least minLength symbols in O(n) by a bottom-up traversal of lcp-intervals
+        // A maximal repeat cannot be extended to the left or right without losing an occurrence. Repeats are
+        // ordered by the end of their suffix ranges, nested ones first. minLength is at least 1.
+        GenericVector<Repeat> maximalRepeats(IndexType minLength) const;
+
+        // Returns minimal lexicographic rotation of the initial text in O(n) time
+        Text minLexRotation() const;
+
+        // Returns start of the minimal lexicographic rotation in the text by minimalRotation() in O(n) time,
+        // the smallest start if several rotations are equal. The rotation is text[start, n) followed by text[0, start).
+        // The smallest suffix does not always start it: "aba" precedes "aab" as a suffix of "baa".
+        IndexType minLexRotationStart() const;
 
 
     private:
 
-        enum class CompareResult { Equal, Smaller, Bigger, Undefined };
+        BasicSuffixArray() = default; // Used by load() and factories
+
+        std::shared_ptr<const Text> m_ownedText; // Input text if owned by the suffix array
+
+        std::shared_ptr<const MappedFile> m_file; // Mapped index file holding the text and the arrays if loaded
 
-        std::string m_text; // Input text
+        TextView m_text; // Input text
 
-        IndexVct m_suffixArray; // Output array
+        IndexType m_indexWidth = sizeof(uint64_t); // Bytes per stored index
 
-        // N * (1 + log(ceil(N))) matrix storing in every line order of sorted prefixes (of suffixes) of length 2^k (0<=k<=ceil(N))
-        GenericVector < IndexVct > m_prefixOrderMatrix;
+        PackedIndexVct m_suffixArray; // Output array
+
+        PackedIndexVct m_rank; // Order of suffix starting at given position, inverse of m_suffixArray
+
+        PackedIndexVct m_lcpArray; // Lengths of longest common prefixes of neighbouring suffixes
+
+        RangeMinimumQuery m_lcpRmq; // Minimum queries over m_lcpArray
+
+        // Builds suffix array and lcp support over m_text
+        void build(const SuffixArrayOptions& options);
 
         void buildSuffixArray();
 
-        // Compares suffix to a given substring
-        // They are equal when substring is a prefix of suffix starting from index idx
-        CompareResult compareSubstring(IndexType idx, const std::string& substr) const;
+        void buildSuffixArrayInducedSorting(IndexType alphabetSize);
 
-        bool isLexEqual(IndexType idx, const std::string& substr) const
-        {
-            return (compareSubstring(idx, substr) == CompareResult::Equal);
-        }
+        void buildSuffixArrayParallel(IndexType threadCount);
+
+        // Builds rank and LCP arrays in O(n) and range minimum query structure over LCP
+        void buildLcpSupport(RmqKind rmqKind);
+
+        // Finds the first order of suffix whose prefix of pattern length is not smaller than pattern,
+        // or with upper set the first order of suffix whose prefix is bigger than pattern
+        // Searched orders are limited to [left, right], which has to contain the result
+        // comparedSymbols, if given, is increased by the number of text symbols compared with the pattern
+        IndexType findBound(TextView pattern, bool upper, IndexType left, IndexType right, IndexType* comparedSymbols = nullptr) const;
+
+        // LCP array stored by lcp support or built by Kasai's algorithm without it
+        IndexVct lcpArrayForScan() const;
 
-        bool isLexSmaller(IndexType idx, const std::string& substr) const
+        // Length of longest common prefix of suffixes of orders a < b using lcp support
+        IndexType lcpOfOrders(IndexType a, IndexType b) const
         {
-            return (compareSubstring(idx, substr) == CompareResult::Smaller);
+            return m_lcpRmq.minimum(m_lcpArray, a + 1, b);
         }
 
-        IndexType outOfRangeVal() const { return m_text.size(); }
+    }; // End of class BasicSuffixArray
 
-    }; // End of class SuffixArray
+    using SuffixArray = BasicSuffixArray<char>;
 
 
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "ThreadPool.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Suffix sorting by induced sorting (SA-IS) in linear time
+    // Symbols of the text are taken as unsigned codes in range [0, alphabetSize)
+    // Suffixes are ordered as if the text was followed by a sentinel smaller than all symbols
+    // Index - type of the stored suffix positions, must be able to represent n
+    template <typename Index, typename Symbol>
+    GenericVector<Index> induceSortSuffixes(const Symbol* text, IndexType n, IndexType alphabetSize)
+    {
+        static_assert(std::is_unsigned<Index>::value, "Index type must be unsigned");
+
+        using Code = std::make_unsigned_t<Symbol>;
+        auto code = [text](IndexType i) { return static_cast<IndexType>(static_cast<Code>(text[i])); };
+
+        constexpr Index Empty = std::numeric_limits<Index>::max(); // Unset suffix array entry
+
+        GenericVector<Index> sa(n, Empty);
+
+        if (n == 0)
+            return sa;
+        if (n == 1)
+        {
+            sa[0] = 0;
+            return sa;
+        }
+
+        // Suffix types: S-type (smaller than the next suffix) or L-type
+        GenericVector<bool> sType(n, false);
+        for (IndexType i = n - 1; i-- > 0;)
+            sType[i] = (code(i) == code(i + 1)) ? sType[i + 1] : (code(i) < code(i + 1));
+
+        // Bucket starts for L-type and S-type suffixes of every symbol
+        IndexVct bucketL(alphabetSize + 1, 0);
+        IndexVct bucketS(alphabetSize + 1, 0);
+        for (IndexType i = 0; i < n; i++)
+        {
+            if (!sType[i])
+                bucketS[code(i)]++;
+            else
+                bucketL[code(i) + 1]++;
+        }
+        for (IndexType c = 0; c <= alphabetSize; c++)
+        {
+            bucketS[c] += bucketL[c];
+            if (c < alphabetSize)
+                bucketL[c + 1] += bucketS[c];
+        }
+
+        // Places sorted LMS suffixes and induces positions of L-type and then S-type suffixes
+        auto induce = [&](const GenericVector<Index>& lms)
+        {
+            std::fill(sa.begin(), sa.end(), Empty);
+
+            IndexVct bucket(bucketS);
+            for (auto pos : lms)
+                sa[bucket[code(pos)]++] = pos;
+
+            bucket = bucketL;
+            sa[bucket[code(n - 1)]++] = static_cast<Index>(n - 1);
+            for (IndexType i = 0; i < n; i++)
+            {
+                const Index pos = sa[i];
+                if (pos != Empty && pos >= 1 && !sType[pos - 1])
+                    sa[bucket[code(pos - 1)]++] = pos - 1;
+            }
+
+            bucket = bucketL;
+            for (IndexType i = n; i-- > 0;)
+            {
+                const Index pos = sa[i];
+                if (pos != Empty && pos >= 1 && sType[pos - 1])
+                    sa[--bucket[code(pos - 1) + 1]] = pos - 1;
+            }
+        };
+
+        // Leftmost S-type positions (LMS) and their order numbers
+        GenericVector<Index> lmsMap(n + 1, Empty);
+        GenericVector<Index> lms;
+        for (IndexType i = 1; i < n; i++)
+        {
+            if (!sType[i - 1] && sType[i])
+            {
+                lmsMap[i] = static_cast<Index>(lms.size());
+                lms.push_back(static_cast<Index>(i));
+            }
+        }
+        const IndexType lmsCount = lms.size();
+
+        induce(lms);
+
+        if (lmsCount > 0)
+        {
+            // LMS suffixes are sorted by their LMS substrings now
+            GenericVector<Index> sortedLms;
+            sortedLms.reserve(lmsCount);
+            for (auto pos : sa)
+            {
+                if (lmsMap[pos] != Empty)
+                    sortedLms.push_back(pos);
+            }
+
+            // Name LMS substrings, equal substrings get equal names
+            GenericVector<Index> reducedText(lmsCount);
+            IndexType name = 0;
+            reducedText[lmsMap[sortedLms[0]]] = 0;
+            for (IndexType i = 1; i < lmsCount; i++)
+            {
+                IndexType l = sortedLms[i - 1];
+                IndexType r = sortedLms[i];
+                const IndexType endL = (lmsMap[l] + 1 < lmsCount) ? lms[lmsMap[l] + 1] : n;
+                const IndexType endR = (lmsMap[r] + 1 < lmsCount) ? lms[lmsMap[r] + 1] : n;
+
+                bool same = true;
+                if (endL - l != endR - r)
+                    same = false;
+                else
+                {
+                    for (; l < endL; l++, r++)
+                    {
+                        if (code(l) != code(r))
+                            break;
+                    }
+                    if (l == n || code(l) != code(r))
+                        same = false;
+                }
+
+                if (!same)
+                    name++;
+                reducedText[lmsMap[sortedLms[i]]] = static_cast<Index>(name);
+            }
+
+            // Sort LMS suffixes recursively over the reduced text and induce the final order
+            const GenericVector<Index> reducedSa = induceSortSuffixes<Index>(reducedText.data(), lmsCount, name + 1);
+            for (IndexType i = 0; i < lmsCount; i++)
+                sortedLms[i] = lms[reducedSa[i]];
+
+            induce(sortedLms);
+        }
+
+        return sa;
+    }
+
+    // Builds LCP array in linear time (Kasai): lcp[i] is the length of the longest common prefix
+    // of suffixes sa[i - 1] and sa[i], lcp[0] is 0. rank is the inverse of sa.
+    template <typename Index, typename Symbol, typename SaArray, typename RankArray>
+    GenericVector<Index> buildLcpArray(const Symbol* text, IndexType n, const SaArray& sa, const RankArray& rank)
+    {
+        GenericVector<Index> lcp(n, 0);
+
+        IndexType len = 0; // Decreases by at most 1 between consecutive text positions
+        for (IndexType i = 0; i < n; i++)
+        {
+            const IndexType r = rank[i];
+            if (r == 0)
+            {
+                len = 0;
+                continue;
+            }
+
+            const IndexType j = sa[r - 1];
+            while (i + len < n && j + len < n && text[i + len] == text[j + len])
+                len++;
+
+            lcp[r] = static_cast<Index>(len);
+            if (len > 0)
+                len--;
+        }
+
+        return lcp;
+    }
+
+    // Minimum number of elements per chunk of the parallel sorts, smaller inputs use fewer chunks
+    constexpr IndexType ParallelSortMinChunk = 1 << 15;
+
+    // Number of chunks to split n elements into for the pool
+    inline IndexType parallelChunkCount(IndexType n, const ThreadPool& pool)
+    {
+        return std::max<IndexType>(1, std::min(pool.size(), n / ParallelSortMinChunk));
+    }
+
+    // Stable LSD radix sort of entries by the lowest keyBits bits of their key member, 11 bits per pass
+    // Every chunk of the input counts its digits, then scatters its entries to offsets following
+    // all smaller digits and the same digit of preceding chunks. Passes where all digits are equal are skipped.
+    // buffer is working space of the same size
+    template <typename Entry>
+    void parallelRadixSort(GenericVector<Entry>& entries, GenericVector<Entry>& buffer, IndexType keyBits, ThreadPool& pool)
+    {
+        constexpr IndexType DigitBits = 11;
+        constexpr IndexType Buckets = IndexType(1) << DigitBits;
+
+        const IndexType n = entries.size();
+        const IndexType chunks = parallelChunkCount(n, pool);
+        GenericVector<IndexType> offsets(chunks * Buckets); // Counts, then scatter offsets of every chunk and digit
+
+        for (IndexType shift = 0; shift < keyBits; shift += DigitBits)
+        {
+            auto digit = [shift](const Entry& entry) { return static_cast<IndexType>(entry.key >> shift) & (Buckets - 1); };
+
+            pool.parallelFor(chunks, chunks, [&](IndexType beg, IndexType end)
+                {
+                    for (IndexType c = beg; c < end; c++)
+                    {
+                        IndexType* count = &offsets[c * Buckets];
+                        std::fill(count, count + Buckets, 0);
+                        for (IndexType i = n * c / chunks; i < n * (c + 1) / chunks; i++)
+                            count[digit(entries[i])]++;
+                    }
+                });
+
+            bool singleDigit = false;
+            IndexType sum = 0;
+            for (IndexType b = 0; b < Buckets; b++)
+            {
+                const IndexType bucketStart = sum;
+                for (IndexType c = 0; c < chunks; c++)
+                {
+                    const IndexType count = offsets[c * Buckets + b];
+                    offsets[c * Buckets + b] = sum;
+                    sum += count;
+                }
+                singleDigit = singleDigit || (sum - bucketStart == n);
+            }
+            if (singleDigit)
+                continue;
+
+            pool.parallelFor(chunks, chunks, [&](IndexType beg, IndexType end)
+                {
+                    for (IndexType c = beg; c < end; c++)
+                    {
+                        IndexType* offset = &offsets[c * Buckets];
+                        for (IndexType i = n * c / chunks; i < n * (c + 1) / chunks; i++)
+                            buffer[offset[digit(entries[i])]++] = entries[i];
+                    }
+                });
+            entries.swap(buffer);
+        }
+    }
+
+    // Suffix sorting by prefix doubling with parallel radix sorts on the pool, O(n log n) work
+    // Positions are first ranked by their symbols. In round k every position gets the pair of dense ranks of its first k
+    // symbols and of the k symbols following them, 0 past the end of text. Positions are radix sorted by the pair,
+    // packed into one 64-bit key whenever both ranks fit 32 bits, and equal pairs get equal new ranks.
+    // Rounds end once all ranks differ. The order is the same as of induceSortSuffixes over unsigned codes of the symbols.
+    // Index - type of the stored suffix positions, must be able to represent n
+    template <typename Index, typename Symbol>
+    GenericVector<Index> parallelSortSuffixes(const Symbol* text, IndexType n, ThreadPool& pool)
+    {
+        static_assert(std::is_unsigned<Index>::value, "Index type must be unsigned");
+
+        using Code = std::make_unsigned_t<Symbol>;
+
+        struct Entry
+        {
+            uint64_t key;
+            Index pos;
+        };
+
+        const IndexType chunks = parallelChunkCount(n, pool);
+        auto forChunks = [&](auto func) { pool.parallelFor(n, chunks, func); };
+
+        GenericVector<Index> rank(n); // Dense rank of the first k symbols, from 1
+        GenericVector<Index> newRank(n);
+        GenericVector<Entry> entries(n);
+        GenericVector<Entry> buffer(n);
+        GenericVector<IndexType> groupStarts(chunks); // Groups starting in preceding chunks
+
+        // Dense ranks from 1 for runs of sorted entries, groupStart(i) tells if entry i differs from entry i - 1
+        auto assignRanks = [&](auto groupStart)
+        {
+            pool.parallelFor(chunks, chunks, [&](IndexType beg, IndexType end)
+                {
+                    for (IndexType c = beg; c < end; c++)
+                    {
+                        groupStarts[c] = 0;
+                        for (IndexType i = n * c / chunks; i < n * (c + 1) / chunks; i++)
+                            groupStarts[c] += (i == 0 || groupStart(i));
+                    }
+                });
+
+            IndexType groups = 0;
+            for (auto& starts : groupStarts)
+            {
+                const IndexType count = starts;
+                starts = groups;
+                groups += count;
+            }
+
+            pool.parallelFor(chunks, chunks, [&](IndexType beg, IndexType end)
+                {
+                    for (IndexType c = beg; c < end; c++)
+                    {
+                        IndexType group = groupStarts[c];
+                        for (IndexType i = n * c / chunks; i < n * (c + 1) / chunks; i++)
+                        {
+                            group += (i == 0 || groupStart(i));
+                            newRank[entries[i].pos] = static_cast<Index>(group);
+                        }
+                    }
+                });
+            rank.swap(newRank);
+            return groups;
+        };
+
+        forChunks([&](IndexType beg, IndexType end)
+            {
+                for (IndexType i = beg; i < end; i++)
+                    entries[i] = { static_cast<Code>(text[i]), static_cast<Index>(i) };
+            });
+        parallelRadixSort(entries, buffer, std::numeric_limits<Code>::digits, pool);
+        IndexType maxRank = assignRanks([&](IndexType i) { return entries[i].key != entries[i - 1].key; });
+
+        for (IndexType k = 1; maxRank < n && k < n; k <<= 1)
+        {
+            IndexType bits = 1;
+            while (bits < std::numeric_limits<uint64_t>::digits && (maxRank >> bits) != 0)
+                bits++;
+            const bool packed = (2 * bits <= std::numeric_limits<uint64_t>::digits);
+
+            auto second = [&](IndexType i) -> uint64_t { return (i + k < n) ? rank[i + k] : 0; };
+
+            // Pairs too wide for one key are sorted by the second rank, then stably by the first one
+            forChunks([&](IndexType beg, IndexType end)
+                {
+                    for (IndexType i = beg; i < end; i++)
+                        entries[i] = { packed ? (uint64_t(rank[i]) << bits | second(i)) : second(i), static_cast<Index>(i) };
+                });
+            parallelRadixSort(entries, buffer, packed ? 2 * bits : bits, pool);
+            if (!packed)
+            {
+                forChunks([&](IndexType beg, IndexType end)
+                    {
+                        for (IndexType i = beg; i < end; i++)
+                            entries[i].key = rank[entries[i].pos];
+                    });
+                parallelRadixSort(entries, buffer, bits, pool);
+            }
+
+            maxRank = assignRanks([&](IndexType i)
+                {
+                    return entries[i].key != entries[i - 1].key || (!packed && second(entries[i].pos) != second(entries[i - 1].pos));
+                });
+        }
+
+        GenericVector<Index> sa(n);
+        forChunks([&](IndexType beg, IndexType end)
+            {
+                for (IndexType i = beg; i < end; i++)
+                    sa[i] = entries[i].pos;
+            });
+        return sa;
+    }
+
+}
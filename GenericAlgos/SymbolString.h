@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <ios>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Character traits for strings of integer symbols such as bytes of binary data or 16/32-bit token ids
+    // Symbols are ordered as unsigned codes, std::char_traits is only provided for character types
+    template <typename Symbol> struct SymbolTraits
+    {
+        static_assert(std::is_integral<Symbol>::value, "Symbols must be integers");
+
+        using char_type = Symbol;
+        using int_type = std::make_unsigned_t<Symbol>;
+        using off_type = std::streamoff;
+        using pos_type = std::streampos;
+        using state_type = std::mbstate_t;
+
+        static void assign(char_type& a, const char_type& b) noexcept { a = b; }
+        static bool eq(char_type a, char_type b) noexcept { return a == b; }
+        static bool lt(char_type a, char_type b) noexcept { return static_cast<int_type>(a) < static_cast<int_type>(b); }
+
+        static int compare(const char_type* a, const char_type* b, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (!eq(a[i], b[i]))
+                    return lt(a[i], b[i]) ? -1 : 1;
+            }
+            return 0;
+        }
+
+        static std::size_t length(const char_type* s)
+        {
+            std::size_t n = 0;
+            while (!eq(s[n], char_type()))
+                n++;
+            return n;
+        }
+
+        static const char_type* find(const char_type* s, std::size_t n, const char_type& c)
+        {
+            const char_type* found = std::find(s, s + n, c);
+            return (found == s + n) ? nullptr : found;
+        }
+
+        static char_type* move(char_type* dst, const char_type* src, std::size_t n)
+        {
+            if (n > 0)
+                std::memmove(dst, src, n * sizeof(char_type));
+            return dst;
+        }
+
+        static char_type* copy(char_type* dst, const char_type* src, std::size_t n)
+        {
+            if (n > 0)
+                std::memcpy(dst, src, n * sizeof(char_type));
+            return dst;
+        }
+
+        static char_type* assign(char_type* s, std::size_t n, char_type c)
+        {
+            std::fill(s, s + n, c);
+            return s;
+        }
+
+        // Every code is a valid symbol, so no int_type value is reserved for the end of file
+        static constexpr int_type eof() noexcept { return std::numeric_limits<int_type>::max(); }
+        static constexpr int_type not_eof(int_type c) noexcept { return (c == eof()) ? 0 : c; }
+        static constexpr char_type to_char_type(int_type c) noexcept { return static_cast<char_type>(c); }
+        static constexpr int_type to_int_type(char_type c) noexcept { return static_cast<int_type>(c); }
+        static constexpr bool eq_int_type(int_type a, int_type b) noexcept { return a == b; }
+    };
+
+    // Standard traits for char, so char texts stay std::string and std::string_view
+    template <typename Symbol>
+    using SymbolTraitsOf = std::conditional_t<std::is_same<Symbol, char>::value, std::char_traits<char>, SymbolTraits<Symbol>>;
+
+    template <typename Symbol> using BasicSymbolString = std::basic_string<Symbol, SymbolTraitsOf<Symbol>>;
+
+    template <typename Symbol> using BasicSymbolView = std::basic_string_view<Symbol, SymbolTraitsOf<Symbol>>;
+
+}
@@ -0,0 +1,69 @@
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "ThreadPool.h"
+
+namespace GADS = GeneralAlgorithmsAndDataStructures;
+
+GADS::ThreadPool::ThreadPool(IndexType threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_workers.reserve(threadCount);
+    try
+    {
+        for (IndexType i = 0; i < threadCount; i++)
+            m_workers.emplace_back([this]() { workerLoop(); });
+    }
+    catch (...)
+    {
+        stop(); // Started workers have to be joined before rethrowing
+        throw;
+    }
+}
+
+GADS::ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+void GADS::ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskReady.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void GADS::ThreadPool::enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+    m_taskReady.notify_one();
+}
+
+// Workers exit once stopping is requested and the queue is drained
+void GADS::ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskReady.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+            if (m_tasks.empty())
+                return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task(); // Exceptions are captured by the packaged task
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Fixed set of worker threads executing queued tasks in FIFO order
+    class ThreadPool
+    {
+    public:
+
+        // Start given number of worker threads, 0 selects the number of hardware threads
+        explicit ThreadPool(IndexType threadCount = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        // Finishes queued tasks and joins the workers
+        ~ThreadPool();
+
+        // Number of worker threads
+        IndexType size() const { return m_workers.size(); }
+
+        // Queue a task, the future receives its result or exception
+        template <typename Func> std::future< std::invoke_result_t<Func> > submit(Func func)
+        {
+            using Result = std::invoke_result_t<Func>;
+
+            auto task = std::make_shared< std::packaged_task<Result()> >(std::move(func));
+            std::future<Result> result = task->get_future();
+            enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        // Run func(beg, end) over chunkCount contiguous chunks of range [0, count) and wait for all of them
+        // Rethrows the first exception thrown by a chunk. Must not be called from a task of the same pool.
+        template <typename Func> void parallelFor(IndexType count, IndexType chunkCount, Func func)
+        {
+            chunkCount = std::max<IndexType>(1, std::min(chunkCount, count));
+
+            GenericVector< std::future<void> > chunks;
+            chunks.reserve(chunkCount);
+            for (IndexType c = 0; c < chunkCount; c++)
+            {
+                const IndexType beg = count * c / chunkCount;
+                const IndexType end = count * (c + 1) / chunkCount;
+                chunks.emplace_back(submit([&func, beg, end]() { func(beg, end); }));
+            }
+
+            for (auto& chunk : chunks)
+                chunk.wait(); // All chunks finish before func goes out of scope
+            for (auto& chunk : chunks)
+                chunk.get();
+        }
+
+    private:
+
+        GenericVector<std::thread> m_workers;
+
+        std::queue< std::function<void()> > m_tasks;
+        std::mutex m_mutex; // Guards m_tasks and m_stopping
+        std::condition_variable m_taskReady;
+        bool m_stopping = false;
+
+        void enqueue(std::function<void()> task);
+
+        void workerLoop();
+
+        // Finishes queued tasks and joins the workers
+        void stop();
+
+    }; // End of class ThreadPool
+
+}
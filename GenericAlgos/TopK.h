@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+	// Bounded selector keeping K elements of a stream which compare last following Comparer rules,
+	// K largest ones for default std::less
+	// The kept elements form a heap with the current threshold (the worst kept element) on top,
+	// a better element replaces the top with a single bubble down
+	template <typename T, IndexType K, typename Comparer = std::less<T> > class TopK : private HeapBase<T, Comparer>
+	{
+		static_assert(K > 0, "TopK requires K > 0");
+
+		using Base = HeapBase<T, Comparer>;
+
+	public:
+
+		// Create empty selector
+		TopK() : Base(m_heapDataStorage) { m_heapDataStorage.reserve(K); }
+
+		TopK(const TopK& other) : Base(m_heapDataStorage), m_heapDataStorage(other.m_heapDataStorage) {}
+		TopK(TopK&& other) noexcept : Base(m_heapDataStorage), m_heapDataStorage(std::move(other.m_heapDataStorage)) {}
+
+		TopK& operator = (const TopK& other)
+		{
+			m_heapDataStorage = other.m_heapDataStorage;
+			return *this;
+		}
+
+		TopK& operator = (TopK&& other) noexcept
+		{
+			m_heapDataStorage = std::move(other.m_heapDataStorage);
+			return *this;
+		}
+
+		// Return number of kept elements
+		using Base::size;
+
+		bool full() const { return m_heapDataStorage.size() == K; }
+
+		// Worst kept element, new elements have to compare after it to be kept once the selector is full
+		const T& threshold() { return Base::top(); }
+
+		// Offer single element to the selector
+		void push(const T& val)
+		{
+			if (!full())
+				insert(val);
+			else if (Comparer()(m_heapDataStorage[TopIdx], val))
+				Base::replaceTop(val);
+		}
+
+		// Offer a range of elements given by random access iterators
+		// Once the selector is full the elements are filtered against the threshold in blocks,
+		// the branch free filtering loop can be vectorized by the compiler for arithmetic types
+		template <typename Iterator> void push(Iterator beg, Iterator end)
+		{
+			for (; beg != end && !full(); ++beg)
+				insert(*beg);
+
+			Comparer compare;
+			uint8_t passed[FilterBlockSize];
+
+			while (beg != end)
+			{
+				const IndexType blockSize = std::min<IndexType>(FilterBlockSize, std::distance(beg, end));
+				const T threshold = m_heapDataStorage[TopIdx]; // Threshold only grows during the block
+
+				for (IndexType i = 0; i < blockSize; i++)
+					passed[i] = compare(threshold, beg[i]);
+
+				for (IndexType i = 0; i < blockSize; i++)
+				{
+					if (passed[i] && compare(m_heapDataStorage[TopIdx], beg[i]))
+						Base::replaceTop(beg[i]);
+				}
+
+				beg += blockSize;
+			}
+		}
+
+		// Merge elements selected by another selector, e.g. one filled by another thread
+		void merge(const TopK& other)
+		{
+			push(other.m_heapDataStorage.cbegin(), other.m_heapDataStorage.cend());
+		}
+
+		// Return copy of kept elements sorted from the best one
+		GenericVector<T> getSorted() const
+		{
+			GenericVector<T> result = m_heapDataStorage;
+			HeapSorter<T, Comparer>(result).sort();
+			return result;
+		}
+
+		// Return kept elements sorted from the best one, the selector is left empty
+		GenericVector<T> extractSorted()
+		{
+			GenericVector<T> result = std::move(m_heapDataStorage);
+			m_heapDataStorage.clear();
+			HeapSorter<T, Comparer>(result).sort();
+			return result;
+		}
+
+	private:
+
+		using Base::TopIdx;
+
+		constexpr static IndexType FilterBlockSize = 256;
+
+		// Storage of the heap data
+		GenericVector<T> m_heapDataStorage;
+
+		void insert(const T& val)
+		{
+			m_heapDataStorage.push_back(val);
+			Base::bubbleUp(Base::getLastIndex());
+		}
+
+	}; // End of class TopK
+
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "GeneralAlgorithmsAndDataStructures.h"
+#include "Heap.h"
+
+namespace GeneralAlgorithmsAndDataStructures
+{
+
+    // Bit vector with O(1) rank queries
+    // Counts of ones are kept before every superblock of 4096 bits (64-bit) and every block of 512 bits (16-bit),
+    // about 5% over the bits themselves
+    class RankBitVector
+    {
+    public:
+
+        // Create empty vector
+        RankBitVector() = default;
+
+        // Create vector holding given bits
+        explicit RankBitVector(const GenericVector<bool>& bits) : m_size(bits.size()), m_words((bits.size() + WordBits - 1) / WordBits, 0)
+        {
+            for (IndexType i = 0; i < m_size; i++)
+            {
+                if (bits[i])
+                    m_words[i / WordBits] |= uint64_t(1) << (i % WordBits);
+            }
+
+            m_superblocks.resize(m_words.size() / WordsPerSuperblock + 1);
+            m_blocks.resize(m_words.size() / WordsPerBlock + 1);
+
+            IndexType ones = 0;
+            for (IndexType w = 0; w <= m_words.size(); w++)
+            {
+                if (w % WordsPerSuperblock == 0)
+                    m_superblocks[w / WordsPerSuperblock] = ones;
+                if (w % WordsPerBlock == 0)
+                    m_blocks[w / WordsPerBlock] = static_cast<uint16_t>(ones - m_superblocks[w / WordsPerSuperblock]);
+                if (w < m_words.size())
+                    ones += popCount(m_words[w]);
+            }
+        }
+
+        IndexType size() const { return m_size; }
+
+        bool operator[](IndexType i) const
+        {
+            return (m_words[i / WordBits] >> (i % WordBits)) & 1;
+        }
+
+        // Number of ones in [0, i)
+        IndexType rank1(IndexType i) const
+        {
+            assert(i <= m_size);
+
+            const IndexType word = i / WordBits;
+            IndexType result = m_superblocks[word / WordsPerSuperblock] + m_blocks[word / WordsPerBlock];
+            for (IndexType w = word / WordsPerBlock * WordsPerBlock; w < word; w++)
+                result += popCount(m_words[w]);
+
+            if (i % WordBits != 0)
+                result += popCount(m_words[word] & ((uint64_t(1) << (i % WordBits)) - 1));
+            return result;
+        }
+
+        // Number of zeros in [0, i)
+        IndexType rank0(IndexType i) const { return i - rank1(i); }
+
+        // Size of the structure in bytes
+        IndexType memoryUsage() const
+        {
+            return m_words.size() * sizeof(uint64_t) + m_superblocks.size() * sizeof(uint64_t) + m_blocks.size() * sizeof(uint16_t);
+        }
+
+    private:
+
+        constexpr static IndexType WordBits = 64;
+        constexpr static IndexType WordsPerBlock = 8;
+        constexpr static IndexType WordsPerSuperblock = 64;
+
+        IndexType m_size = 0;
+        GenericVector<uint64_t> m_words;
+        GenericVector<uint64_t> m_superblocks; // Ones before every superblock
+        GenericVector<uint16_t> m_blocks; // Ones before every block counted from its superblock
+
+        static IndexType popCount(uint64_t val)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(val);
+#else
+            IndexType result = 0;
+            for (; val; val &= val - 1)
+                result++;
+            return result;
+#endif
+        }
+
+    }; // End of class RankBitVector
+
+    // Huffman-shaped wavelet tree over a sequence of bytes with access and rank queries
+    // Frequent symbols get short codes, so the bits take about n * H0 of the sequence
+    class WaveletTree
+    {
+    public:
+
+        constexpr static IndexType AlphabetSize = std::numeric_limits<unsigned char>::max() + 1;
+
+        // Create empty tree
+        WaveletTree() = default;
+
+        // Build tree over given sequence of byte codes
+        explicit WaveletTree(const GenericVector<uint8_t>& data) : m_size(data.size())
+        {
+            std::array<IndexType, AlphabetSize> frequency = {};
+            for (auto c : data)
+                frequency[c]++;
+
+            buildHuffmanTree(frequency);
+            if (!m_nodes.empty())
+                buildBits(0, 0, data);
+        }
+
+        IndexType size() const { return m_size; }
+
+        // Symbol at position i
+        uint8_t access(IndexType i) const
+        {
+            return accessRank(i).first;
+        }
+
+        // Symbol at position i and number of its occurrences in [0, i)
+        std::pair<uint8_t, IndexType> accessRank(IndexType i) const
+        {
+            assert(i < m_size);
+
+            if (m_nodes.empty())
+                return { m_singleSymbol, i };
+
+            IndexType node = 0;
+            for (;;)
+            {
+                const Node& current = m_nodes[node];
+                const bool bit = current.bits[i];
+                i = bit ? current.bits.rank1(i) : current.bits.rank0(i);
+
+                if (current.child[bit] < 0)
+                    return { static_cast<uint8_t>(-current.child[bit] - 1), i };
+                node = current.child[bit];
+            }
+        }
+
+        // Number of occurrences of symbol c in [0, i)
+        IndexType rank(uint8_t c, IndexType i) const
+        {
+            assert(i <= m_size);
+
+            if (m_nodes.empty())
+                return (c == m_singleSymbol && m_size > 0) ? i : 0;
+
+            const Code& code = m_codes[c];
+            if (code.length == 0)
+                return 0; // Symbol does not occur
+
+            IndexType node = 0;
+            for (IndexType depth = 0; depth < code.length; depth++)
+            {
+                const Node& current = m_nodes[node];
+                const bool bit = (code.bits >> depth) & 1;
+                i = bit ? current.bits.rank1(i) : current.bits.rank0(i);
+                node = current.child[bit];
+            }
+            return i;
+        }
+
+        // Size of the structure in bytes
+        IndexType memoryUsage() const
+        {
+            IndexType bytes = sizeof(m_codes);
+            for (const auto& node : m_nodes)
+                bytes += sizeof(Node) + node.bits.memoryUsage();
+            return bytes;
+        }
+
+    private:
+
+        // Internal node, child >= 0 is a node index, child < 0 is a leaf with symbol -child - 1
+        struct Node
+        {
+            RankBitVector bits; // Bit of the code at node depth for every symbol routed through the node
+            int32_t child[2] = { 0, 0 };
+        };
+
+        // Huffman code of a symbol, bit of depth d at position d
+        struct Code
+        {
+            uint64_t bits = 0;
+            IndexType length = 0;
+        };
+
+        IndexType m_size = 0;
+        GenericVector<Node> m_nodes; // Root at 0, empty if the sequence has at most one distinct symbol
+        std::array<Code, AlphabetSize> m_codes = {};
+        uint8_t m_singleSymbol = 0; // The only symbol of the sequence if m_nodes is empty
+
+        // Merges two least frequent subtrees until one tree remains, subtrees are leaves (-symbol - 1) or node indexes
+        void buildHuffmanTree(const std::array<IndexType, AlphabetSize>& frequency)
+        {
+            MinHeap< std::pair<IndexType, int32_t> > subtrees;
+            for (IndexType c = 0; c < AlphabetSize; c++)
+            {
+                if (frequency[c] > 0)
+                    subtrees.insert(frequency[c], -static_cast<int32_t>(c) - 1);
+            }
+
+            if (subtrees.size() <= 1)
+            {
+                if (subtrees.size() == 1)
+                    m_singleSymbol = static_cast<uint8_t>(-subtrees.top().second - 1);
+                return;
+            }
+
+            // Nodes are created bottom up and reversed afterwards to place the root at 0
+            GenericVector<Node> nodes;
+            while (subtrees.size() > 1)
+            {
+                const auto first = subtrees.extractTop();
+                const auto second = subtrees.extractTop();
+
+                Node node;
+                node.child[0] = first.second;
+                node.child[1] = second.second;
+                nodes.emplace_back(std::move(node));
+                subtrees.insert(first.first + second.first, static_cast<int32_t>(nodes.size() - 1));
+            }
+
+            const int32_t last = static_cast<int32_t>(nodes.size() - 1);
+            for (auto& node : nodes)
+            {
+                for (auto& child : node.child)
+                {
+                    if (child >= 0)
+                        child = last - child;
+                }
+            }
+            m_nodes.assign(std::make_move_iterator(nodes.rbegin()), std::make_move_iterator(nodes.rend()));
+
+            assignCodes(0, Code());
+        }
+
+        void assignCodes(int32_t node, Code prefix)
+        {
+            for (int bit = 0; bit < 2; bit++)
+            {
+                Code code = prefix;
+                assert(code.length < std::numeric_limits<uint64_t>::digits); // Requires Fibonacci-like frequencies over 10^13 symbols
+                code.bits |= uint64_t(bit) << code.length;
+                code.length++;
+
+                const int32_t child = m_nodes[node].child[bit];
+                if (child < 0)
+                    m_codes[-child - 1] = code;
+                else
+                    assignCodes(child, code);
+            }
+        }
+
+        // Stores code bits at depth of the node for its subsequence and distributes it to the children
+        void buildBits(int32_t node, IndexType depth, const GenericVector<uint8_t>& data)
+        {
+            GenericVector<bool> bits(data.size());
+            GenericVector<uint8_t> childData[2];
+            for (IndexType i = 0; i < data.size(); i++)
+            {
+                bits[i] = (m_codes[data[i]].bits >> depth) & 1;
+                childData[bits[i]].push_back(data[i]);
+            }
+            m_nodes[node].bits = RankBitVector(bits);
+
+            for (int bit = 0; bit < 2; bit++)
+            {
+                if (m_nodes[node].child[bit] >= 0)
+                    buildBits(m_nodes[node].child[bit], depth + 1, childData[bit]);
+            }
+        }
+
+    }; // End of class WaveletTree
+
+}
@@ -3,6 +3,11 @@
 
 #include "GeneralAlgorithmsAndDataStructures.h"
 #include "Heap.h"
+#include "RadixHeap.h"
+#include "TopK.h"
+#include "SlidingWindowQuantile.h"
+#include "SplitHeap.h"
+#include "ExternalHeap.h"
 
 namespace GADS = GeneralAlgorithmsAndDataStructures;
 
@@ -30,6 +35,7 @@ struct ClassData
 
 bool operator < (const ClassData& lhs, const ClassData& rhs) { return lhs.value < rhs.value; }
 bool operator == (const ClassData& lhs, const ClassData& rhs) { return lhs.value == rhs.value; }
+bool operator > (const ClassData& lhs, const ClassData& rhs) { return lhs.value > rhs.value; }
 
 
 void testHeapBasic()
@@ -104,6 +110,32 @@ void testHeapBasic()
     GADS::MaxHeap<int> maxHeap5 = { 4,2,1 };
     v = maxHeap5.extractTop();
     assert(v == 4);
+
+    // Deleted item replaced by a smaller one from another subtree
+    GADS::MinHeap<int> minHeap4 = { 1,10,2,11,12,3,4 };
+    minHeap4.deleteItem(11);
+    for (int expected : { 1,2,3,4,10,12 })
+    {
+        v = minHeap4.extractTop();
+        assert(v == expected);
+    }
+
+    // Item moved to the top sifted down over several levels
+    GADS::MinHeap<int> minHeap5 = { 1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 };
+    for (int expected = 1; expected <= 15; expected++)
+    {
+        v = minHeap5.extractTop();
+        assert(v == expected);
+    }
+
+    // Item moved in place of a deleted one belonging above it
+    GADS::MinHeap<int> minHeap6 = { 5,34,34,46,45,11,17 };
+    minHeap6.deleteItem(46);
+    for (int expected : { 5,11,17,34,34,45 })
+    {
+        v = minHeap6.extractTop();
+        assert(v == expected);
+    }
 }
 
 
@@ -139,12 +171,363 @@ void testHeapSort()
     assert(std::is_sorted(vct.cbegin(), vct.cend()));
 }
 
+void testRadixHeap()
+{
+    GADS::RadixHeap<uint64_t, int> radixHeap;
+    radixHeap.insert(8, 80);
+    radixHeap.insert(3, 30);
+    radixHeap.insert(5, 50);
+    radixHeap.insert(3, 31);
+    assert(radixHeap.size() == 4);
+    assert(radixHeap.top().first == 3);
+
+    auto e = radixHeap.extractTop();
+    assert(e.first == 3);
+    e = radixHeap.extractTop();
+    assert(e.first == 3);
+
+    // Keys equal to the last extracted one are still accepted
+    radixHeap.insert(3, 32);
+    radixHeap.insert(1ull << 40, 0);
+    e = radixHeap.extractTop();
+    assert(e.first == 3 && e.second == 32);
+    e = radixHeap.extractTop();
+    assert(e.first == 5 && e.second == 50);
+    e = radixHeap.extractTop();
+    assert(e.first == 8 && e.second == 80);
+    e = radixHeap.extractTop();
+    assert(e.first == (1ull << 40));
+    assert(radixHeap.empty());
+
+    // Handling incorrect input
+    bool exceptionHandled = false;
+    try
+    {
+        radixHeap.insert(7, 70); // Below last extracted key
+    }
+    catch (const std::invalid_argument&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    exceptionHandled = false;
+    try
+    {
+        radixHeap.extractTop();
+    }
+    catch (const std::out_of_range&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    // Monotone sequence matches MinHeap order
+    GADS::RadixHeap<uint32_t, ClassData> radixHeap2;
+    GADS::MinHeap<uint32_t> minHeap;
+    uint32_t seed = 7;
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            uint32_t key = radixHeap2.lastKey() + (seed >> 16) % 1000;
+            radixHeap2.insert(key, static_cast<int>(key));
+            minHeap.insert(key);
+        }
+
+        for (int i = 0; i < 5; i++)
+        {
+            auto entry = radixHeap2.extractTop();
+            assert(entry.first == minHeap.extractTop());
+            assert(entry.second.value == static_cast<int>(entry.first));
+        }
+    }
+    assert(radixHeap2.size() == minHeap.size());
+}
+
+void testTopK()
+{
+    GADS::TopK<int, 3> topK;
+    topK.push(5);
+    topK.push(1);
+    assert(topK.size() == 2);
+    assert(!topK.full());
+
+    topK.push(7);
+    assert(topK.full());
+    assert(topK.threshold() == 1);
+
+    topK.push(0); // Below threshold
+    topK.push(6);
+    assert(topK.threshold() == 5);
+
+    GADS::GenericVector<int> expected = { 7,6,5 };
+    assert(topK.getSorted() == expected);
+
+    // Range input filtered in blocks
+    GADS::GenericVector<int> stream(1000);
+    for (size_t i = 0; i < stream.size(); i++)
+        stream[i] = static_cast<int>((i * 7919) % 1000);
+
+    GADS::TopK<int, 5> topK2;
+    topK2.push(stream.begin(), stream.end());
+    expected = { 999,998,997,996,995 };
+    assert(topK2.getSorted() == expected);
+
+    // Merging partial results
+    GADS::TopK<int, 5> topK3;
+    GADS::TopK<int, 5> topK4;
+    topK3.push(stream.begin(), stream.begin() + 500);
+    topK4.push(stream.begin() + 500, stream.end());
+    topK3.merge(topK4);
+    assert(topK3.extractSorted() == expected);
+    assert(topK3.size() == 0);
+
+    // Smallest elements with reversed comparer
+    GADS::TopK<ClassData, 2, std::greater<ClassData> > bottomK;
+    for (int v : { 4,2,8,1,6 })
+        bottomK.push(ClassData(v));
+    GADS::GenericVector<ClassData> bottom = bottomK.getSorted();
+    assert(bottom.size() == 2);
+    assert(bottom[0] == 1);
+    assert(bottom[1] == 2);
+}
+
+// Reference quantile recomputed for the whole window
+int windowQuantile(const GADS::GenericVector<int>& data, size_t beg, size_t end, double q)
+{
+    GADS::GenericVector<int> window(data.begin() + beg, data.begin() + end);
+    GADS::IndexType rank = static_cast<GADS::IndexType>(q * (window.size() - 1));
+    return GADS::findNthSmallestElem<int>(window.begin(), window.end(), rank + 1);
+}
+
+void testSlidingWindowQuantile()
+{
+    GADS::SlidingWindowMedian<int> median;
+    median.push(5);
+    assert(median.median() == 5);
+    median.push(1);
+    assert(median.median() == 1); // Lower median
+    median.push(3);
+    assert(median.median() == 3);
+    median.evictOldest();
+    assert(median.median() == 1);
+    median.push(4);
+    assert(median.median() == 3);
+    median.evictOldest(3);
+    assert(median.size() == 0);
+
+    // Handling incorrect input
+    bool exceptionHandled = false;
+    try
+    {
+        median.median();
+    }
+    catch (const std::out_of_range&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    exceptionHandled = false;
+    try
+    {
+        GADS::SlidingWindowQuantile<int> invalid(1.5);
+    }
+    catch (const std::invalid_argument&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    // Compare with recomputing every window, data with duplicates
+    GADS::GenericVector<int> data(500);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<int>((i * 7919 + i * i) % 97);
+
+    for (double q : { 0.0, 0.25, 0.5, 0.9, 1.0 })
+    {
+        const size_t windowSize = 31;
+        GADS::SlidingWindowQuantile<int> tracker(q);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            tracker.push(data[i]);
+            if (tracker.size() > windowSize)
+                tracker.evictOldest();
+
+            size_t beg = (i + 1 > windowSize) ? i + 1 - windowSize : 0;
+            assert(tracker.quantile() == windowQuantile(data, beg, i + 1, q));
+        }
+
+        // Batched windows, overlapping and disjoint
+        for (size_t step : { 1, 7, 40 })
+        {
+            GADS::GenericVector<int> quantiles = GADS::slidingWindowQuantiles(data, windowSize, step, q);
+            assert(quantiles.size() == (data.size() - windowSize) / step + 1);
+            for (size_t w = 0; w < quantiles.size(); w++)
+                assert(quantiles[w] == windowQuantile(data, w * step, w * step + windowSize, q));
+        }
+    }
+}
+
+struct LargeRecord
+{
+    LargeRecord(int k, const std::string& n) : key(k), name(n) {}
+
+    int key;
+    std::string name;
+    char payload[200] = {};
+};
+
+struct LargeRecordKey
+{
+    int operator()(const LargeRecord& r) const { return r.key; }
+};
+
+struct ClassDataKey
+{
+    int operator()(const ClassData& d) const { return d.value; }
+};
+
+void testSplitHeap()
+{
+    // Large records use split layout, small ones plain heap
+    static_assert(std::is_same<GADS::KeyedHeap<LargeRecord, LargeRecordKey>, GADS::SplitHeap<LargeRecord, LargeRecordKey> >::value, "Split layout expected");
+    static_assert(!std::is_same<GADS::KeyedHeap<ClassData, ClassDataKey>, GADS::SplitHeap<ClassData, ClassDataKey> >::value, "Plain layout expected");
+
+    GADS::KeyedHeap<LargeRecord, LargeRecordKey> heap;
+    heap.insert(5, "five");
+    heap.insert(2, "two");
+    heap.insert(LargeRecord(7, "seven"));
+    heap.insert(1, "one");
+    assert(heap.size() == 4);
+    assert(heap.top().name == "one");
+    assert(heap.topKey() == 1);
+
+    LargeRecord r = heap.extractTop();
+    assert(r.key == 1 && r.name == "one");
+
+    // Released slots are reused
+    heap.insert(3, "three");
+    for (int expected : { 2,3,5,7 })
+    {
+        r = heap.extractTop();
+        assert(r.key == expected);
+    }
+    assert(heap.size() == 0);
+
+    // Elements left in the heap are destroyed with it, moved heap keeps them
+    GADS::SplitHeap<LargeRecord, LargeRecordKey, std::greater<int> > maxHeap;
+    for (int i = 0; i < 3000; i++)
+        maxHeap.insert((i * 7919) % 3000, std::to_string(i));
+    for (int i = 0; i < 1000; i++)
+        maxHeap.extractTop();
+    auto movedHeap = std::move(maxHeap);
+    assert(movedHeap.size() == 2000);
+    assert(movedHeap.topKey() == 1999);
+
+    // Plain layout keeps the same interface
+    GADS::KeyedHeap<ClassData, ClassDataKey> smallHeap;
+    smallHeap.insert(4);
+    smallHeap.insert(2);
+    assert(smallHeap.extractTop().value == 2);
+}
+
+void testExternalHeap()
+{
+    // Handling incorrect input
+    bool exceptionHandled = false;
+    try
+    {
+        GADS::ExternalHeap<int> tooSmall(1024, 1024);
+    }
+    catch (const std::invalid_argument&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    // Small budget: 1024 elements in memory, at most 16 runs of 64 element blocks
+    GADS::ExternalHeap<uint32_t> heap(8192, 256);
+    GADS::MinHeap<uint32_t> reference;
+    uint32_t seed = 11;
+
+    for (int round = 0; round < 40; round++)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            heap.insert(seed >> 8);
+            reference.insert(seed >> 8);
+        }
+
+        for (int i = 0; i < 300; i++)
+        {
+            assert(heap.top() == reference.top());
+            assert(heap.extractTop() == reference.extractTop());
+        }
+    }
+
+    assert(heap.size() == reference.size());
+    while (reference.size() > 0)
+        assert(heap.extractTop() == reference.extractTop());
+
+    const GADS::ExternalHeapStats& stats = heap.ioStats();
+    assert(stats.runsWritten > 4);
+    assert(stats.runMerges > 0);
+    assert(stats.bytesRead == stats.bytesWritten);
+    assert(stats.blocksRead > 0);
+
+    exceptionHandled = false;
+    try
+    {
+        heap.extractTop();
+    }
+    catch (const std::out_of_range&)
+    {
+        exceptionHandled = true;
+    }
+    assert(exceptionHandled);
+
+    // Interleaved inserts and extracts exhausting every new run while one old run stays: exhausted runs
+    // do not count towards the run limit, so nothing is merged and every element is written and read once
+    GADS::ExternalHeap<uint32_t> interleaved(8192, 256);
+    for (uint32_t i = 0; i < 1024; i++)
+        interleaved.insert(1000000000 + i);
+
+    const uint32_t rounds = 20; // More than the 16 runs the budget allows
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        // Last insert spills the previous 1024 elements as a run
+        for (uint32_t i = 0; i <= 1024; i++)
+            interleaved.insert(round * 2000 + i);
+        for (uint32_t i = 0; i <= 1024; i++)
+            assert(interleaved.extractTop() == round * 2000 + i);
+    }
+    for (uint32_t i = 0; i < 1024; i++)
+        assert(interleaved.extractTop() == 1000000000 + i);
+
+    const GADS::ExternalHeapStats& interleavedStats = interleaved.ioStats();
+    assert(interleavedStats.runMerges == 0);
+    assert(interleavedStats.runsWritten == rounds + 1);
+    assert(interleavedStats.bytesWritten == (rounds + 1) * 1024 * sizeof(uint32_t));
+    assert(interleavedStats.blocksWritten == (rounds + 1) * 16);
+    assert(interleavedStats.bytesRead == interleavedStats.bytesWritten);
+    assert(interleavedStats.blocksRead == interleavedStats.blocksWritten);
+}
+
 int main()
 {
     testHeapBasic();
     testHeapObjects();
     testHeapSorter();
     testHeapSort();
+    testRadixHeap();
+    testTopK();
+    testSlidingWindowQuantile();
+    testSplitHeap();
+    testExternalHeap();
 
     std::cout << "--- All binary heap tests executed ---" << std::endl;
 }
@@ -1,7 +1,11 @@
 #include <iostream>
 #include <cassert>
+#include <random>
 
 #include "GeneralAlgorithmsAndDataStructures.h"
+#include "FuzzyDictionary.h"
+#include "StringDistance.h"
+#include "ThreadPool.h"
 
 namespace GADS = GeneralAlgorithmsAndDataStructures;
 
@@ -444,6 +448,229 @@ void testLongestCommonSubsequence()
 
 }
 
+// Random string over alphabetSize characters starting at first
+std::string makeRandomString(GADS::IndexType len, unsigned alphabetSize, unsigned seed, char first = 'a')
+{
+    std::mt19937 gen(seed);
+    std::string result(len, first);
+    for (auto& c : result)
+        c = static_cast<char>(first + gen() % alphabetSize);
+    return result;
+}
+
+// Length of the longest common subsequence by the dynamic programming recurrence over two rows
+GADS::IndexType lcsLengthNaive(const std::string& s1, const std::string& s2)
+{
+    GADS::IndexVct prev(s2.size() + 1, 0);
+    GADS::IndexVct cur(s2.size() + 1, 0);
+    for (GADS::IndexType i = 1; i <= s1.size(); i++)
+    {
+        for (GADS::IndexType j = 1; j <= s2.size(); j++)
+            cur[j] = (s1[i - 1] == s2[j - 1]) ? prev[j - 1] + 1 : std::max(cur[j - 1], prev[j]);
+        prev.swap(cur);
+    }
+    return prev.back();
+}
+
+void testLongestCommonSubsequenceLength()
+{
+    assert(GADS::longestCommonSubsequenceLength("anaconda", "anagram") == 4);
+    assert(GADS::longestCommonSubsequenceLength("", "abc") == 0);
+    assert(GADS::longestCommonSubsequenceLength("abc", "") == 0);
+    assert(GADS::longestCommonSubsequenceLength("abc", "def") == 0);
+
+    // Lengths around word and AVX2 group borders, scalar and vector kernels agree with the dynamic programming
+    const GADS::IndexType lengths[] = { 1, 5, 63, 64, 65, 127, 128, 129, 255, 256, 257, 300, 513, 1000 };
+    unsigned seed = 1;
+    for (const auto len1 : lengths)
+    {
+        for (const auto len2 : { GADS::IndexType(1), GADS::IndexType(64), GADS::IndexType(200), GADS::IndexType(700) })
+        {
+            const unsigned alphabetSize = (seed % 3 == 0) ? 2 : (seed % 3 == 1) ? 4 : 26;
+            const char first = (seed % 2) ? 'a' : '\xF0'; // Bytes above 127 as well
+            const std::string s1 = makeRandomString(len1, alphabetSize, seed++, first);
+            const std::string s2 = makeRandomString(len2, alphabetSize, seed++, first);
+
+            const GADS::IndexType expected = lcsLengthNaive(s1, s2);
+            assert(GADS::longestCommonSubsequenceLength(s1, s2, GADS::SimdLevel::None) == expected);
+            assert(GADS::longestCommonSubsequenceLength(s1, s2, GADS::SimdLevel::AVX2) == expected);
+            assert(GADS::longestCommonSubsequenceLength(s2, s1) == expected);
+            assert(GADS::longestCommonSubsequence(s1, s2) == expected);
+        }
+    }
+
+    // Texts longer than the tiles of the vector kernel
+    const std::string longText = makeRandomString(5000, 4, 101);
+    const std::string longPattern = makeRandomString(300, 4, 102);
+    const GADS::IndexType longExpected = lcsLengthNaive(longText, longPattern);
+    assert(GADS::longestCommonSubsequenceLength(longText, longPattern, GADS::SimdLevel::None) == longExpected);
+    assert(GADS::longestCommonSubsequenceLength(longText, longPattern, GADS::SimdLevel::AVX2) == longExpected);
+
+    // Long carry chains: a run of matches spanning several words
+    const std::string ones(1000, 'a');
+    assert(GADS::longestCommonSubsequenceLength(ones, ones + "b" + ones) == 1000);
+    assert(GADS::longestCommonSubsequenceLength(ones + "b" + ones, "b" + ones, GADS::SimdLevel::None) == 1001);
+    assert(GADS::longestCommonSubsequenceLength(ones + "b" + ones, "b" + ones, GADS::SimdLevel::AVX2) == 1001);
+}
+
+// Checks if sub is a subsequence of s
+bool isSubsequence(const std::string& sub, const std::string& s)
+{
+    GADS::IndexType matched = 0;
+    for (GADS::IndexType i = 0; i < s.size() && matched < sub.size(); i++)
+    {
+        if (s[i] == sub[matched])
+            matched++;
+    }
+    return matched == sub.size();
+}
+
+void testLongestCommonSubsequenceWitness()
+{
+    std::string witness = "old";
+    assert(GADS::longestCommonSubsequenceWitness("anaconda", "anagram", witness) == 4);
+    assert(witness == "anaa");
+    assert(GADS::longestCommonSubsequenceWitness("", "abc", witness) == 0 && witness.empty());
+    assert(GADS::longestCommonSubsequenceWitness("abc", "def", witness) == 0 && witness.empty());
+
+    // Witness is a common subsequence of the optimal length, including splits over word borders of the columns
+    unsigned seed = 7;
+    for (const auto len1 : { GADS::IndexType(1), GADS::IndexType(2), GADS::IndexType(17), GADS::IndexType(130), GADS::IndexType(900) })
+    {
+        for (const auto len2 : { GADS::IndexType(1), GADS::IndexType(3), GADS::IndexType(64), GADS::IndexType(257), GADS::IndexType(1100) })
+        {
+            const unsigned alphabetSize = 2 + seed % 5;
+            const std::string s1 = makeRandomString(len1, alphabetSize, seed);
+            const std::string s2 = makeRandomString(len2, alphabetSize, seed + 1);
+            seed += 2;
+            const GADS::IndexType expected = lcsLengthNaive(s1, s2);
+
+            for (const auto simd : { GADS::SimdLevel::None, GADS::SimdLevel::AVX2 })
+            {
+                assert(GADS::longestCommonSubsequenceWitness(s1, s2, witness, simd) == expected);
+                assert(witness.size() == expected);
+                assert(isSubsequence(witness, s1) && isSubsequence(witness, s2));
+            }
+        }
+    }
+}
+
+void testLongestCommonSubsequences()
+{
+    assert(GADS::longestCommonSubsequences("anaconda", "anagram", 10) == GADS::GenericVector<std::string>({ "anaa" }));
+    assert(GADS::longestCommonSubsequences("abc", "cba", 10) == GADS::GenericVector<std::string>({ "a", "b", "c" }));
+    assert(GADS::longestCommonSubsequences("abc", "cba", 2) == GADS::GenericVector<std::string>({ "a", "b" }));
+    assert(GADS::longestCommonSubsequences("abc", "def", 10).empty());
+    assert(GADS::longestCommonSubsequences("abc", "abc", 0).empty());
+
+    // All subsequences of the LCS length of short strings, checked against the second string
+    for (unsigned seed = 1; seed <= 60; seed++)
+    {
+        const std::string s1 = makeRandomString(1 + seed % 11, 2 + seed % 3, seed);
+        const std::string s2 = makeRandomString(1 + seed * 7 % 13, 2 + seed % 3, seed + 1000);
+        const GADS::IndexType length = lcsLengthNaive(s1, s2);
+
+        GADS::GenericSet<std::string> expected;
+        for (GADS::IndexType mask = 0; mask < (GADS::IndexType(1) << s1.size()); mask++)
+        {
+            std::string sub;
+            for (GADS::IndexType i = 0; i < s1.size(); i++)
+            {
+                if (mask & (GADS::IndexType(1) << i))
+                    sub += s1[i];
+            }
+            if (length > 0 && sub.size() == length && isSubsequence(sub, s2))
+                expected.insert(sub);
+        }
+
+        const GADS::GenericVector<std::string> all = GADS::longestCommonSubsequences(s1, s2, 1000000);
+        assert(all == GADS::GenericVector<std::string>(expected.begin(), expected.end()));
+
+        const GADS::GenericVector<std::string> capped = GADS::longestCommonSubsequences(s1, s2, 3);
+        assert(capped == GADS::GenericVector<std::string>(all.begin(), all.begin() + std::min<GADS::IndexType>(all.size(), 3)));
+
+        GADS::GenericSet<std::string> sequences;
+        assert(GADS::longestCommonSubsequence(s1, s2, &sequences) == length);
+        assert(length == 0 || sequences == expected);
+    }
+
+    // Exponentially many subsequences: every block "abc" against "bac" contributes "ac" or "bc", over 2^40 in total
+    std::string ab;
+    std::string ba;
+    for (int i = 0; i < 40; i++)
+    {
+        ab += "abc";
+        ba += "bac";
+    }
+    const GADS::GenericVector<std::string> first = GADS::longestCommonSubsequences(ab, ba, 50);
+    assert(first.size() == 50);
+    assert(std::is_sorted(first.begin(), first.end()));
+    for (const auto& sequence : first)
+        assert(sequence.size() == 80 && isSubsequence(sequence, ab) && isSubsequence(sequence, ba));
+    assert(std::adjacent_find(first.begin(), first.end()) == first.end());
+
+    // Legacy overload is capped as well
+    GADS::GenericSet<std::string> sequences;
+    assert(GADS::longestCommonSubsequence(ab, ba, &sequences) == 80);
+    assert(sequences.size() == GADS::DefaultMaxSubsequences);
+    assert(GADS::longestCommonSubsequence(ab, ba, &sequences, 50) == 80);
+    assert(sequences == GADS::GenericSet<std::string>(first.begin(), first.end()));
+}
+
+// Weighted costs depending on the characters, so swapping inserted and deleted characters changes the result
+struct WeightedCostPolicy
+{
+    using CostType = int64_t;
+
+    CostType matchCost(char c1, char c2) const { return (c1 == c2) ? 0 : 3 + (c1 < c2); }
+    CostType insertCost(char c) const { return 1 + (c - 'a'); }
+    CostType deleteCost(char c) const { return 2 + 2 * (c - 'a'); }
+};
+
+// Full table edit distance with the costs of WeightedCostPolicy
+int64_t weightedEditDistanceNaive(const std::string& s1, const std::string& s2)
+{
+    const WeightedCostPolicy costs;
+    GADS::GenericVector<GADS::GenericVector<int64_t>> t(s1.size() + 1, GADS::GenericVector<int64_t>(s2.size() + 1, 0));
+    for (GADS::IndexType i = 0; i <= s1.size(); i++)
+    {
+        for (GADS::IndexType j = 0; j <= s2.size(); j++)
+        {
+            if (i == 0 && j == 0)
+                continue;
+            int64_t best = std::numeric_limits<int64_t>::max();
+            if (i > 0 && j > 0)
+                best = std::min(best, t[i - 1][j - 1] + costs.matchCost(s1[i - 1], s2[j - 1]));
+            if (j > 0)
+                best = std::min(best, t[i][j - 1] + costs.insertCost(s2[j - 1]));
+            if (i > 0)
+                best = std::min(best, t[i - 1][j] + costs.deleteCost(s1[i - 1]));
+            t[i][j] = best;
+        }
+    }
+    return t.back().back();
+}
+
+// Unit costs except the insertion of 'x'
+class ExpensiveInsertConfig : public GADS::MatchConfigGenericImpl
+{
+public:
+    GADS::ValueType insertCost(char c) const override { return (c == 'x') ? 5 : 1; }
+};
+
+// Subclass keeping the unit costs
+class TrivialMatchConfig : public GADS::MatchConfigGenericImpl
+{
+};
+
+// Configuration overriding the deprecated table hooks, which approximativeStringMatching() ignores
+class LegacyTableConfig : public GADS::MatchConfigGenericImpl
+{
+public:
+    Table createTable(GADS::IndexType tableD1, GADS::IndexType tableD2) const override { return Table(tableD1, Row(tableD2, 0)); }
+    GADS::IndexType getResult(const Table&) const override { return 0; }
+};
+
 void testApproximativeStringMatching()
 {
     const std::string s1 = "kola";
@@ -463,6 +690,317 @@ void testApproximativeStringMatching()
     apprCost = GADS::approximativeStringMatching(s1,s3,matchConfig);
     assert(apprCost == 3);
 
+    // Traceback of the aligned characters
+    GADS::GenericSet<std::string> sequences;
+    apprCost = GADS::approximativeStringMatching(s1, s2, matchConfig, &sequences);
+    assert(apprCost == 1 && sequences == GADS::GenericSet<std::string>{ "kola" });
+    apprCost = GADS::approximativeStringMatching(s1, s3, matchConfig, &sequences);
+    assert(apprCost == 3 && sequences == GADS::GenericSet<std::string>{ "a" });
+    apprCost = GADS::approximativeStringMatching("abc", "xyz", matchConfig, &sequences);
+    assert(apprCost == 3 && sequences == GADS::GenericSet<std::string>{ "" });
+    apprCost = GADS::approximativeStringMatching("", "", matchConfig, &sequences);
+    assert(apprCost == 0 && sequences == GADS::GenericSet<std::string>{ "" });
+
+    // Inserted characters come from s2, deleted ones from s1
+    const WeightedCostPolicy weighted;
+    assert(GADS::approximativeStringMatching("", "ab", weighted) == 1 + 2);
+    assert(GADS::approximativeStringMatching("ab", "", weighted) == 2 + 4);
+    assert(GADS::approximativeStringMatching("ab", "", weighted, &sequences) == 2 + 4);
+
+    // insertCost() is charged for the inserted character of s2, before the cost policies it got s1[i - 1]
+    // "a" to "ax" substitutes 'x' for 'a' and inserts 'a', the former kernel charged the cheap 'a' of s1 for
+    // inserting 'x' and returned 1
+    const ExpensiveInsertConfig expensiveInsert;
+    assert(GADS::approximativeStringMatching("a", "ax", expensiveInsert) == 2);
+    assert(GADS::approximativeStringMatching("a", "ax", expensiveInsert, &sequences) == 2);
+    assert(GADS::approximativeStringMatching("xxxx", "xxxxx", expensiveInsert) == 5);
+    assert(GADS::approximativeStringMatching("ax", "a", expensiveInsert) == 1);
+    assert(GADS::approximativeStringMatching("a", "ab", expensiveInsert) == 1);
+
+    // Unit costs are detected on the characters present, whatever the class of the configuration
+    const TrivialMatchConfig trivial;
+    assert(GADS::approximativeStringMatching("kitten", "sitting", trivial) == 3);
+    assert(GADS::approximativeStringMatching("kitten", "sitting", expensiveInsert) == 3);
+
+    const LegacyTableConfig legacy;
+    assert(GADS::approximativeStringMatching("kitten", "sitting", legacy) == 3);
+    assert(GADS::approximativeStringMatching("kitten", "sitting", legacy, &sequences) == 3);
+
+    // Policy kernel against the virtual interface and the full table, with and without traceback
+    for (unsigned seed = 0; seed < 100; seed++)
+    {
+        const std::string a = makeRandomString(seed % 37, 2 + seed % 5, seed);
+        const std::string b = makeRandomString((seed * 7) % 41, 2 + seed % 5, seed + 1000);
+
+        const int32_t unit = GADS::approximativeStringMatching(a, b, GADS::UnitCostPolicy());
+        assert(static_cast<GADS::IndexType>(unit) == GADS::approximativeStringMatching(a, b, matchConfig));
+        assert(unit >= 0 && static_cast<GADS::IndexType>(unit) <= std::max(a.size(), b.size()));
+
+        const int64_t expected = weightedEditDistanceNaive(a, b);
+        assert(GADS::approximativeStringMatching(a, b, weighted) == expected);
+        assert(GADS::approximativeStringMatching(a, b, weighted, &sequences) == expected);
+        assert(sequences.size() == 1 && isSubsequence(*sequences.begin(), a) && isSubsequence(*sequences.begin(), b));
+
+        assert(GADS::approximativeStringMatching(a, b, GADS::UnitCostPolicy(), &sequences) == unit);
+        assert(sequences.begin()->size() + unit >= std::max(a.size(), b.size()));
+    }
+
+}
+
+// Copy of s with edits random edits, substitutions, insertions and deletions
+std::string mutateString(const std::string& s, GADS::IndexType edits, unsigned alphabetSize, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::string result = s;
+    for (GADS::IndexType e = 0; e < edits; e++)
+    {
+        const char c = static_cast<char>('a' + gen() % alphabetSize);
+        const GADS::IndexType pos = result.empty() ? 0 : gen() % result.size();
+        switch (gen() % 3)
+        {
+        case 0:
+            if (!result.empty())
+                result[pos] = c;
+            break;
+        case 1:
+            result.insert(result.begin() + pos, c);
+            break;
+        default:
+            if (!result.empty())
+                result.erase(result.begin() + pos);
+        }
+    }
+    return result;
+}
+
+void testEditDistance()
+{
+    assert(GADS::editDistance("", "") == 0);
+    assert(GADS::editDistance("", "abc") == 3);
+    assert(GADS::editDistance("abc", "") == 3);
+    assert(GADS::editDistance("kola", "koala") == 1);
+    assert(GADS::editDistance("kitten", "sitting") == 3);
+    assert(GADS::editDistanceWithin("kitten", "sitting", 3) == 3);
+    assert(GADS::editDistanceWithin("kitten", "sitting", 2) == 3);
+    assert(GADS::editDistanceWithin("kitten", "sitting", 0) == 1);
+    assert(GADS::editDistanceWithin("", "abc", 1) == 2);
+    assert(GADS::editDistanceWithin("abc", "abc", 0) == 0);
+    assert(GADS::editDistanceWithin("abc", "xyz", std::numeric_limits<GADS::IndexType>::max()) == 3);
+
+    // Random pairs across block borders against the dynamic programming
+    for (unsigned seed = 0; seed < 120; seed++)
+    {
+        const std::string a = makeRandomString(seed * 3 % 200, 2 + seed % 4, seed);
+        const std::string b = makeRandomString(seed * 7 % 230, 2 + seed % 4, seed + 500);
+        const GADS::IndexType expected = GADS::approximativeStringMatching(a, b, GADS::UnitCostPolicy());
+        assert(GADS::editDistance(a, b) == expected);
+        assert(GADS::editDistance(b, a) == expected);
+
+        for (GADS::IndexType k : { GADS::IndexType(0), expected / 2, expected - (expected > 0), expected, expected + 1, expected + 64 })
+            assert(GADS::editDistanceWithin(a, b, k) == std::min(expected, k + 1));
+    }
+
+    // Similar long strings, the band is narrow against the pattern
+    for (unsigned seed = 0; seed < 40; seed++)
+    {
+        const std::string a = makeRandomString(300 + seed * 37, 2 + seed % 5, seed);
+        const std::string b = mutateString(a, seed % 50, 2 + seed % 5, seed + 77);
+        const GADS::IndexType expected = GADS::approximativeStringMatching(a, b, GADS::UnitCostPolicy());
+        assert(GADS::editDistance(a, b) == expected);
+
+        for (GADS::IndexType k = 0; k <= expected + 3; k++)
+        {
+            assert(GADS::editDistanceWithin(a, b, k) == std::min(expected, k + 1));
+            assert(GADS::editDistanceWithin(b, a, k) == std::min(expected, k + 1));
+        }
+    }
+}
+
+// Words of the dictionary within k of query, or all of them with their distances, sorted like the search results
+GADS::GenericVector<GADS::FuzzyMatch> fuzzyMatchesNaive(const GADS::GenericVector<std::string>& words, const std::string& query, GADS::IndexType k)
+{
+    GADS::GenericVector<GADS::FuzzyMatch> matches;
+    for (GADS::IndexType w = 0; w < words.size(); w++)
+    {
+        const GADS::IndexType distance = GADS::editDistance(words[w], query);
+        if (distance <= k)
+            matches.push_back({ w, distance });
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+void testFuzzyDictionary()
+{
+    const GADS::GenericVector<std::string> words = { "kitten", "sitting", "mitten", "kit", "", "kitten", "smitten", "written" };
+    const GADS::FuzzyDictionary dictionary(words);
+    assert(dictionary.size() == words.size());
+
+    auto exact = dictionary.findWithin("kitten", 0);
+    assert((exact == GADS::GenericVector<GADS::FuzzyMatch>{ { 0, 0 }, { 5, 0 } }));
+    assert((dictionary.findWithin("mitten", 1) == GADS::GenericVector<GADS::FuzzyMatch>{ { 2, 0 }, { 0, 1 }, { 5, 1 }, { 6, 1 } }));
+    assert((dictionary.findWithin("", 0) == GADS::GenericVector<GADS::FuzzyMatch>{ { 4, 0 } }));
+    assert(dictionary.findWithin("zzzzzzzzzzzz", 3).empty());
+    assert((dictionary.findNearest("kiten", 3) == GADS::GenericVector<GADS::FuzzyMatch>{ { 0, 1 }, { 5, 1 }, { 2, 2 } }));
+    assert(dictionary.findNearest("kiten", 100).size() == words.size());
+    assert(dictionary.findNearest("kiten", 0).empty());
+
+    // Unlimited bound reports every word
+    const GADS::FuzzyDictionary small({ "kitten", "sitting", "abc", "a" });
+    assert((small.findWithin("kitten", std::numeric_limits<GADS::IndexType>::max())
+        == GADS::GenericVector<GADS::FuzzyMatch>{ { 0, 0 }, { 1, 3 }, { 2, 6 }, { 3, 6 } }));
+    assert(small.findWithin("kitten", std::numeric_limits<GADS::IndexType>::max()) == small.findWithin("kitten", 100));
+
+    GADS::IndexType visited = 0;
+    dictionary.findWithin("kitten", 1, &visited);
+    assert(visited > 0 && visited <= dictionary.nodeCount());
+
+    // Random dictionaries with shared prefixes and duplicates against edit distances to every word
+    for (unsigned seed = 0; seed < 12; seed++)
+    {
+        const unsigned alphabetSize = 2 + seed % 4;
+        GADS::GenericVector<std::string> randomWords;
+        for (unsigned w = 0; w < 300; w++)
+        {
+            if (w % 7 == 3)
+                randomWords.push_back(mutateString(randomWords[w / 2], 1 + w % 3, alphabetSize, seed * 1000 + w));
+            else
+                randomWords.push_back(makeRandomString(w * 13 % 11, alphabetSize, seed * 1000 + w));
+        }
+        const GADS::FuzzyDictionary randomDictionary(randomWords);
+
+        GADS::GenericVector<std::string> queries;
+        for (unsigned q = 0; q < 30; q++)
+            queries.push_back((q % 2 == 0) ? mutateString(randomWords[q * 7], q % 4, alphabetSize, seed + q) : makeRandomString(q % 13, alphabetSize, seed + q));
+
+        for (const auto& query : queries)
+        {
+            for (GADS::IndexType k = 0; k <= 4; k++)
+                assert(randomDictionary.findWithin(query, k) == fuzzyMatchesNaive(randomWords, query, k));
+
+            const auto all = fuzzyMatchesNaive(randomWords, query, std::numeric_limits<GADS::IndexType>::max());
+            for (GADS::IndexType count : { 1, 5, 40, 1000 })
+            {
+                const auto nearest = randomDictionary.findNearest(query, count);
+                assert(nearest == GADS::GenericVector<GADS::FuzzyMatch>(all.begin(), all.begin() + std::min(count, all.size())));
+            }
+        }
+
+        // Batches in parallel equal single searches, visited nodes are summed
+        const GADS::GenericVector<std::string_view> views(queries.begin(), queries.end());
+        GADS::ThreadPool pool(3);
+        GADS::IndexType singleVisited = 0;
+        GADS::IndexType batchVisited = 0;
+        const auto within = randomDictionary.findWithin(views, 2, &pool, &batchVisited);
+        const auto nearest = randomDictionary.findNearest(views, 10, &pool, &batchVisited);
+        for (GADS::IndexType q = 0; q < queries.size(); q++)
+        {
+            assert(within[q] == randomDictionary.findWithin(queries[q], 2, &singleVisited));
+            assert(nearest[q] == randomDictionary.findNearest(queries[q], 10, &singleVisited));
+        }
+        assert(batchVisited == singleVisited);
+        assert(randomDictionary.findWithin(views, 2) == within);
+    }
+}
+
+// Substitutions of neighbouring keys of the keyboard cost less, deletions are cheaper than insertions
+class KeyboardMatchConfig : public GADS::MatchConfigGenericImpl
+{
+public:
+    explicit KeyboardMatchConfig(GADS::ValueType scale) : scale(scale) {}
+
+    GADS::ValueType matchCost(char c1, char c2) const override
+    {
+        static const std::string rows[] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+        if (c1 == c2)
+            return 0;
+        for (const auto& row : rows)
+        {
+            const auto p1 = row.find(c1);
+            const auto p2 = row.find(c2);
+            if (p1 != std::string::npos && p2 != std::string::npos && (p1 + 1 == p2 || p2 + 1 == p1))
+                return scale;
+        }
+        return 3 * scale;
+    }
+    GADS::ValueType insertCost(char c) const override { return 2 * scale + (c % 3); }
+    GADS::ValueType deleteCost(char) const override { return scale; }
+
+private:
+    GADS::ValueType scale;
+};
+
+void testWeightedEditDistance()
+{
+    const GADS::EditCostTable unit;
+    assert(GADS::weightedEditDistance("kitten", "sitting", unit) == 3);
+    assert(GADS::weightedEditDistance("", "abc", unit) == 3);
+    assert(GADS::weightedEditDistance("abc", "", unit) == 3);
+
+    GADS::EditCostTable custom;
+    custom.setDeleteCost('x', 0);
+    assert(GADS::weightedEditDistance("axxxb", "ab", custom) == 0);
+    assert(GADS::weightedEditDistance("ab", "axxxb", custom) == 3);
+
+    bool thrown = false;
+    try
+    {
+        custom.setMatchCost('a', 'b', -1);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Against the scalar kernel under the same configuration, scales push the lanes to 8, 16 and 32 bits
+    const GADS::SimdLevel levels[] = { GADS::SimdLevel::None, GADS::SimdLevel::SSE2, GADS::SimdLevel::AVX2 };
+    for (GADS::ValueType scale : { 1, 40, 3000, 1000000 })
+    {
+        const KeyboardMatchConfig config(scale);
+        const GADS::EditCostTable table(config);
+        for (unsigned seed = 0; seed < 40; seed++)
+        {
+            const std::string a = makeRandomString(seed * 13 % 150, 4 + seed % 20, seed);
+            const std::string b = (seed % 3 == 0) ? mutateString(a, seed % 7, 4 + seed % 20, seed + 9)
+                : makeRandomString(seed * 29 % 170, 4 + seed % 20, seed + 300);
+            const GADS::IndexType expected = GADS::approximativeStringMatching(a, b, config);
+            for (const auto simd : levels)
+            {
+                assert(GADS::weightedEditDistance(a, b, table, simd) == expected);
+                assert(GADS::weightedEditDistance(b, a, table, simd) == GADS::approximativeStringMatching(b, a, config));
+            }
+        }
+    }
+
+    // Over the 32-bit lanes
+    GADS::EditCostTable huge;
+    huge.setInsertCost('a', 2000000000);
+    huge.setMatchCost('b', 'a', 2000000000);
+    assert(GADS::weightedEditDistance("b", "aa", huge) == GADS::IndexType(4000000000));
+    assert(GADS::weightedEditDistance("bbbb", "aaaa", huge) == GADS::IndexType(8000000000));
+    assert(GADS::weightedEditDistance("ab", "abb", huge) == 1);
+
+    // Long strings over all byte values, distances across the 8 and 16-bit caps
+    GADS::EditCostTable bytes;
+    for (unsigned c = 0; c < GADS::EditCostTable::SymbolCount; c++)
+    {
+        bytes.setInsertCost(static_cast<char>(c), 1 + c % 4);
+        bytes.setDeleteCost(static_cast<char>(c), 1 + c % 5);
+        for (unsigned d = 0; d < GADS::EditCostTable::SymbolCount; d++)
+            bytes.setMatchCost(static_cast<char>(c), static_cast<char>(d), (c == d) ? 0 : 1 + (c ^ d) % 6);
+    }
+    for (GADS::IndexType len : { 500, 3000 })
+    {
+        const std::string a = makeRandomString(len, 256, 11, 0);
+        for (GADS::IndexType edits : { GADS::IndexType(20), len / 8, len })
+        {
+            const std::string b = mutateString(a, edits, 256, 12);
+            const GADS::IndexType expected = GADS::approximativeStringMatching(std::string_view(a), std::string_view(b), bytes);
+            for (const auto simd : levels)
+                assert(GADS::weightedEditDistance(a, b, bytes, simd) == expected);
+        }
+    }
 }
 
 void testPartitionRange()
@@ -554,6 +1092,55 @@ void testPartitionRange()
 
 
 
+void testThreadPool()
+{
+    GADS::ThreadPool pool(4);
+    assert(pool.size() == 4);
+
+    auto square = pool.submit([]() { return 7 * 7; });
+    assert(square.get() == 49);
+
+    // Exceptions are passed to the future
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    bool thrown = false;
+    try
+    {
+        failing.get();
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Every index is visited exactly once
+    GADS::GenericVector<int> visits(1000, 0);
+    pool.parallelFor(visits.size(), 7, [&visits](GADS::IndexType beg, GADS::IndexType end)
+        {
+            for (GADS::IndexType i = beg; i < end; i++)
+                visits[i]++;
+        });
+    assert(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+
+    pool.parallelFor(0, 3, [](GADS::IndexType, GADS::IndexType) {});
+
+    // Queued tasks are finished before the pool is destroyed
+    GADS::IndexType done = 0;
+    std::mutex doneMutex;
+    {
+        GADS::ThreadPool shortLived(2);
+        for (int i = 0; i < 20; i++)
+        {
+            shortLived.submit([&]()
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done++;
+                });
+        }
+    }
+    assert(done == 20);
+}
+
 int main()
 {
     testBinarySearch();
@@ -570,8 +1157,15 @@ int main()
     testGenerateSubsets();
     testModularExp();
     testLongestCommonSubsequence();
+    testLongestCommonSubsequenceLength();
+    testLongestCommonSubsequenceWitness();
+    testLongestCommonSubsequences();
     testApproximativeStringMatching();
+    testEditDistance();
+    testWeightedEditDistance();
+    testFuzzyDictionary();
     testPartitionRange();
+    testThreadPool();
 
     std::cout << "--- All basic tests executed ---" << std::endl;
 }
@@ -1,8 +1,17 @@
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 
 #include "GeneralAlgorithmsAndDataStructures.h"
+#include "FMIndex.h"
+#include "GeneralizedSuffixArray.h"
+#include "SegmentedSuffixArray.h"
+#include "StringRotation.h"
 #include "SuffixArray.h"
+#include "ThreadPool.h"
 
 namespace GADS = GeneralAlgorithmsAndDataStructures;
 
@@ -27,14 +36,14 @@ void testBuildSuffixArray()
 void testGetNthSuffix()
 {
     const GADS::SuffixArray sa3("bOBocEl");
-    const std::string suf1 = sa3.getNthSuffix(3);
+    const std::string_view suf1 = sa3.getNthSuffix(3);
     assert(suf1 == "OBocEl");
 
     // Handling incorrect input
     bool exceptionHandled = false;
     try
     {
-        const std::string suf2 = sa3.getNthSuffix(10);
+        const std::string_view suf2 = sa3.getNthSuffix(10);
         (void)suf2; // Supress compiler warning
     }
     catch (const std::out_of_range&)
@@ -117,6 +126,924 @@ void testMiinLexRotation()
     const GADS::SuffixArray sa6("alabala");
     std::string minRotation2 = sa6.minLexRotation();
     assert(minRotation2 == "aalabal");
+
+    // The smallest suffix "a" does not start the smallest rotation
+    const GADS::SuffixArray sa7("baa");
+    assert(sa7.minLexRotation() == "aab");
+    assert(sa7.minLexRotationStart() == 1);
+}
+
+// Simple deterministic text generator over first alphabetSize lowercase letters
+std::string makeText(size_t len, unsigned alphabetSize, unsigned seed)
+{
+    std::string text(len, 'a');
+    for (auto& c : text)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>('a' + (seed >> 16) % alphabetSize);
+    }
+    return text;
+}
+
+void testMinimalRotation()
+{
+    assert(GADS::minimalRotation(std::string()) == 0);
+    assert(GADS::minimalRotation(std::string("aaaa")) == 0);
+    assert(GADS::minimalRotation(std::string("abab")) == 0);
+    assert(GADS::minimalRotation(std::string("baa")) == 1);
+    assert(GADS::minimalRotation(std::string("abcab")) == 3);
+    assert(GADS::minimalRotation(std::string("a\xF0\0", 3)) == 2); // Unsigned order, NUL is the smallest symbol
+
+    assert(GADS::lyndonFactorization(std::string("banana")) == (GADS::IndexVct{ 0, 1, 3, 5 })); // b | an | an | a
+    assert(GADS::lyndonFactorization(std::string()).empty());
+    assert(GADS::isLyndonWord(std::string("aab")) && GADS::isLyndonWord(std::string("a")));
+    assert(!GADS::isLyndonWord(std::string("abab")) && !GADS::isLyndonWord(std::string("ba")) && !GADS::isLyndonWord(std::string()));
+
+    // Smallest start of the smallest rotation and non-increasing Lyndon factors, against brute force
+    for (unsigned seed = 1; seed <= 300; seed++)
+    {
+        const std::string base = makeText(seed % 23, 2 + seed % 3, seed);
+        const std::string text = (seed % 4 == 0) ? base + base + base : base; // Periodic texts
+
+        GADS::IndexType expected = 0;
+        for (GADS::IndexType start = 1; start < text.size(); start++)
+        {
+            if (text.substr(start) + text.substr(0, start) < text.substr(expected) + text.substr(0, expected))
+                expected = start;
+        }
+        assert(GADS::minimalRotation(text) == expected);
+
+        const GADS::GenericVector<uint32_t> tokens(text.begin(), text.end());
+        assert(GADS::minimalRotation(tokens) == expected);
+
+        const GADS::IndexVct starts = GADS::lyndonFactorization(text);
+        assert(starts.empty() == text.empty());
+        std::string previous;
+        for (GADS::IndexType f = 0; f < starts.size(); f++)
+        {
+            const GADS::IndexType end = (f + 1 < starts.size()) ? starts[f + 1] : text.size();
+            const std::string factor = text.substr(starts[f], end - starts[f]);
+            assert(GADS::isLyndonWord(factor));
+            for (GADS::IndexType r = 1; r < factor.size(); r++)
+                assert(factor < factor.substr(r) + factor.substr(0, r));
+            assert(f == 0 || factor <= previous);
+            previous = factor;
+        }
+    }
+}
+
+void testInducedSorting()
+{
+    const GADS::SuffixArray sa1("bOBocEl", GADS::SuffixArrayConstruction::InducedSorting);
+    const GADS::IndexVct expectedResult1 = { 2,5,1,0,4,6,3 };
+    assert(sa1.get() == expectedResult1);
+
+    const GADS::SuffixArray sa2("", GADS::SuffixArrayConstruction::InducedSorting);
+    assert(sa2.get().empty());
+
+    const GADS::SuffixArray sa3("x", GADS::SuffixArrayConstruction::InducedSorting);
+    assert(sa3.get() == GADS::IndexVct{ 0 });
+
+    // Same result as prefix doubling for random and repetitive texts
+    const std::string texts[] = { makeText(1000, 2, 1), makeText(1000, 26, 2), std::string(300, 'a'),
+        "mississippi", "abracadabraabracadabra", "aab" };
+    for (const auto& text : texts)
+    {
+        const GADS::SuffixArray doubling(text, GADS::SuffixArrayConstruction::PrefixDoubling);
+        const GADS::SuffixArray inducing(text, GADS::SuffixArrayConstruction::InducedSorting);
+        assert(doubling.get() == inducing.get());
+    }
+
+    const GADS::SuffixArray sa4("lalala", GADS::SuffixArrayConstruction::InducedSorting);
+    assert(sa4.lcp(0, 2) == 4);
+    assert(sa4.lcp(1, 5) == 1);
+    assert(sa4.searchSubstring("ala") < 6);
+}
+
+void testParallelConstruction()
+{
+    auto parallel = [](const std::string& text, GADS::IndexType threads)
+    {
+        const GADS::SuffixArrayOptions options(GADS::SuffixArrayConstruction::ParallelPrefixDoubling, GADS::LcpSupport::BlockSparseTable,
+            GADS::IndexWidth::Auto, threads);
+        return GADS::SuffixArray(text, options);
+    };
+
+    assert(parallel("", 2).get().empty());
+    assert(parallel("x", 2).get() == GADS::IndexVct{ 0 });
+    assert(parallel("bOBocEl", 2).get() == (GADS::IndexVct{ 2, 5, 1, 0, 4, 6, 3 }));
+
+    // Same result as induced sorting for any number of threads, also with inputs split into several chunks
+    std::string highBytes = makeText(5000, 4, 3);
+    for (size_t i = 0; i < highBytes.size(); i += 7)
+        highBytes[i] = static_cast<char>(0xF0 + i % 3);
+    const std::string texts[] = { makeText(100000, 2, 1), makeText(200000, 26, 2), std::string(70000, 'a'), highBytes,
+        "mississippi", "abracadabraabracadabra", std::string("a\0b\0a\0", 6) };
+    for (const auto& text : texts)
+    {
+        const GADS::IndexVct expected = GADS::SuffixArray(text, GADS::SuffixArrayConstruction::InducedSorting).get();
+        for (GADS::IndexType threads : { 1, 3, 4 })
+        {
+            const GADS::SuffixArray sa = parallel(text, threads);
+            assert(sa.get() == expected);
+            assert(sa.getLcpArray() == GADS::SuffixArray(text).getLcpArray());
+        }
+    }
+}
+
+// Suffix order by direct comparison of unsigned symbol codes, shorter suffix first on a common prefix
+template <typename Symbol> GADS::IndexVct sortSuffixesNaive(const GADS::GenericVector<Symbol>& text)
+{
+    using Code = std::make_unsigned_t<Symbol>;
+
+    GADS::IndexVct order(text.size());
+    for (GADS::IndexType i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&text](GADS::IndexType a, GADS::IndexType b)
+        {
+            return std::lexicographical_compare(text.begin() + a, text.end(), text.begin() + b, text.end(),
+                [](Symbol x, Symbol y) { return static_cast<Code>(x) < static_cast<Code>(y); });
+        });
+    return order;
+}
+
+template <typename Symbol> void testSymbolType(const GADS::GenericVector<Symbol>& symbols, GADS::IndexType alphabetSize)
+{
+    using SymbolArray = GADS::BasicSuffixArray<Symbol>;
+    const typename SymbolArray::Text text(symbols.begin(), symbols.end());
+    const GADS::IndexVct expected = sortSuffixesNaive(symbols);
+
+    const GADS::SuffixArrayConstruction constructions[] = { GADS::SuffixArrayConstruction::InducedSorting,
+        GADS::SuffixArrayConstruction::PrefixDoubling, GADS::SuffixArrayConstruction::ParallelPrefixDoubling };
+    for (auto construction : constructions)
+    {
+        const SymbolArray sa(text, GADS::SuffixArrayOptions(construction, GADS::LcpSupport::BlockSparseTable, GADS::IndexWidth::Auto, 2));
+        assert(sa.get() == expected);
+    }
+
+    const SymbolArray hinted(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting,
+        GADS::LcpSupport::BlockSparseTable, GADS::IndexWidth::Auto, 0, alphabetSize));
+    assert(hinted.get() == expected);
+
+    // Searches and lcp over the same unsigned order
+    for (GADS::IndexType start : { GADS::IndexType(0), text.size() / 3, text.size() - 2 })
+    {
+        const typename SymbolArray::TextView pattern = typename SymbolArray::TextView(text).substr(start, 2);
+        GADS::IndexType occurrences = 0;
+        for (GADS::IndexType i = 0; i + 1 < text.size(); i++)
+            occurrences += (text[i] == pattern[0] && text[i + 1] == pattern[1]);
+        assert(hinted.count(pattern) == occurrences);
+        assert(hinted.searchSubstring(pattern) < hinted.size());
+        for (GADS::IndexType pos : hinted.occurrences(pattern))
+            assert(hinted.getInputText().substr(pos, 2) == pattern);
+    }
+    for (GADS::IndexType x = 0, y = 1; y < text.size(); x += 7, y += 11)
+    {
+        GADS::IndexType len = 0;
+        while (y + len < text.size() && text[x + len] == text[y + len])
+            len++;
+        assert(hinted.lcp(x, y) == len);
+    }
+
+    // Saved and loaded with the symbol size
+    const std::string path = "SuffixArrayUT.symbols.idx";
+    hinted.save(path);
+    const SymbolArray loaded = SymbolArray::load(path, true);
+    assert(loaded.get() == expected && loaded.getInputText() == hinted.getInputText());
+    std::remove(path.c_str());
+}
+
+void testSymbolTypes()
+{
+    // Binary data with NUL bytes and bytes over 127, as char and as uint8_t
+    GADS::GenericVector<char> bytes;
+    for (const char c : makeText(3000, 3, 5))
+        bytes.push_back(static_cast<char>((c - 'a') * 127)); // 0, 127 and 254
+    testSymbolType(bytes, 255);
+    testSymbolType(GADS::GenericVector<uint8_t>(bytes.begin(), bytes.end()), 255);
+
+    const GADS::SuffixArray zeros(std::string(5, '\0'));
+    assert(zeros.get() == (GADS::IndexVct{ 4, 3, 2, 1, 0 }));
+
+    // 16 and 32-bit token ids, huge 32-bit ids are renumbered for induced sorting
+    GADS::GenericVector<uint16_t> shortTokens;
+    GADS::GenericVector<uint32_t> tokens;
+    GADS::GenericVector<uint32_t> hugeTokens;
+    for (const char c : makeText(5000, 7, 9))
+    {
+        shortTokens.push_back(static_cast<uint16_t>((c - 'a') * 10000));
+        tokens.push_back(static_cast<uint32_t>(c - 'a') * 97);
+        hugeTokens.push_back(0xFFFFFFFFu - static_cast<uint32_t>(c - 'a') * 600000000u);
+    }
+    testSymbolType(shortTokens, 60001);
+    testSymbolType(tokens, 6 * 97 + 1);
+    testSymbolType(hugeTokens, 0);
+
+    bool thrown = false;
+    try
+    {
+        GADS::BasicSuffixArray<uint32_t>(GADS::BasicSuffixArray<uint32_t>::Text(tokens.begin(), tokens.end()),
+            GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::None, GADS::IndexWidth::Auto, 0, 100));
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Index files of another symbol size are rejected
+    const std::string path = "SuffixArrayUT.symbols.idx";
+    GADS::SuffixArray("abc").save(path);
+    thrown = false;
+    try
+    {
+        GADS::BasicSuffixArray<uint16_t>::load(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path.c_str());
+}
+
+void testLcpSupport()
+{
+    const GADS::SuffixArray sa1("banana");
+    const GADS::IndexVct expectedLcp1 = { 0,1,3,0,0,2 }; // a, ana, anana, banana, na, nana
+    assert(sa1.getLcpArray() == expectedLcp1);
+
+    // All lcp supports agree with direct comparison
+    const std::string text = makeText(700, 3, 5);
+    const GADS::SuffixArray plain(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::None));
+    const GADS::SuffixArray sparse(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::SparseTable));
+    const GADS::SuffixArray blocked(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::PrefixDoubling, GADS::LcpSupport::BlockSparseTable));
+    assert(plain.getLcpArray().empty());
+
+    for (GADS::IndexType x = 0; x < text.size(); x += 3)
+    {
+        for (GADS::IndexType y = 0; y < text.size(); y += 7)
+        {
+            const GADS::IndexType expected = plain.lcp(x, y);
+            assert(sparse.lcp(x, y) == expected);
+            assert(blocked.lcp(x, y) == expected);
+        }
+    }
+
+    assert(plain.memoryUsage() < blocked.memoryUsage());
+    assert(blocked.memoryUsage() < sparse.memoryUsage());
+}
+
+void testIndexWidth()
+{
+    const std::string text = makeText(900, 4, 11);
+    const GADS::SuffixArray wide(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::SparseTable, GADS::IndexWidth::Bits64));
+    const GADS::SuffixArray narrow(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::SparseTable, GADS::IndexWidth::Bits32));
+    const GADS::SuffixArray medium(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::PrefixDoubling, GADS::LcpSupport::SparseTable, GADS::IndexWidth::Bits40));
+    const GADS::SuffixArray automatic(text);
+
+    assert(wide.getIndexWidth() == 8 && medium.getIndexWidth() == 5 && narrow.getIndexWidth() == 4 && automatic.getIndexWidth() == 4);
+
+    assert(narrow.get() == wide.get());
+    assert(medium.get() == wide.get());
+    assert(narrow.getLcpArray() == wide.getLcpArray());
+    assert(medium.getLcpArray() == wide.getLcpArray());
+
+    assert(wide.size() == text.size());
+    for (GADS::IndexType i = 0; i < wide.size(); i++)
+        assert(narrow.getPosition(i) == wide.getPosition(i));
+
+    for (GADS::IndexType x = 0; x < text.size(); x += 5)
+    {
+        const GADS::IndexType y = (x * 7) % text.size();
+        assert(medium.lcp(x, y) == wide.lcp(x, y));
+        assert(narrow.lcp(x, y) == wide.lcp(x, y));
+    }
+
+    const std::string pattern = text.substr(100, 6);
+    assert(narrow.searchSubstring(pattern) == wide.searchSubstring(pattern));
+    assert(medium.searchSubstring(pattern) == wide.searchSubstring(pattern));
+
+    assert(narrow.memoryUsage() < medium.memoryUsage());
+    assert(medium.memoryUsage() < wide.memoryUsage());
+
+    bool thrown = false;
+    try
+    {
+        narrow.getNthSuffix(text.size() + 1);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void testSaveLoad()
+{
+    const std::string path = "SuffixArrayUT.idx";
+    const std::string text = makeText(1000, 3, 17);
+
+    const GADS::SuffixArrayOptions optionsList[] = {
+        GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::BlockSparseTable),
+        GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::SparseTable, GADS::IndexWidth::Bits40),
+        GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, GADS::LcpSupport::None) };
+
+    for (const auto& options : optionsList)
+    {
+        const GADS::SuffixArray built(text, options);
+        built.save(path);
+
+        const GADS::SuffixArray loaded = GADS::SuffixArray::load(path, true);
+        assert(loaded.getInputText() == text);
+        assert(loaded.get() == built.get());
+        assert(loaded.getLcpArray() == built.getLcpArray());
+        assert(loaded.getIndexWidth() == built.getIndexWidth());
+        assert(loaded.memoryUsage() == built.memoryUsage());
+
+        for (GADS::IndexType x = 0; x < text.size(); x += 9)
+            assert(loaded.lcp(x, (x * 13) % text.size()) == built.lcp(x, (x * 13) % text.size()));
+
+        const std::string pattern = text.substr(500, 7);
+        assert(loaded.searchSubstring(pattern) == built.searchSubstring(pattern));
+        assert(loaded.minLexRotation() == built.minLexRotation());
+    }
+
+    // Copies keep the mapping alive
+    GADS::SuffixArray copy("x");
+    {
+        const GADS::SuffixArray loaded = GADS::SuffixArray::load(path);
+        copy = loaded;
+    }
+    assert(copy.getNthSuffix(1) == text.substr(copy.getPosition(0)));
+
+    // Tiny texts
+    for (const std::string tiny : { "", "a", "ab" })
+    {
+        GADS::SuffixArray(tiny).save(path);
+        const GADS::SuffixArray loaded = GADS::SuffixArray::load(path, true);
+        assert(loaded.get() == GADS::SuffixArray(tiny).get());
+        assert(loaded.getLcpArray() == GADS::SuffixArray(tiny).getLcpArray());
+    }
+
+    auto loadThrows = [&path](bool verifyChecksum)
+    {
+        try
+        {
+            GADS::SuffixArray::load(path, verifyChecksum);
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    // Corrupted payload is detected by the checksum
+    GADS::SuffixArray(text).save(path);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(200);
+        file.put('#');
+    }
+    assert(loadThrows(true));
+
+    // Truncated file
+    GADS::SuffixArray(text).save(path);
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() - 16);
+    }
+    assert(loadThrows(false));
+
+    // Not an index file
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "plain text file";
+    }
+    assert(loadThrows(false));
+
+    std::remove(path.c_str());
+    assert(loadThrows(false));
+}
+
+void testNonOwningText()
+{
+    const std::string text = makeText(600, 4, 23);
+    const GADS::SuffixArray owning(text);
+
+    // Suffix array over caller's text uses it without copying
+    const GADS::SuffixArray viewing = GADS::SuffixArray::fromView(text);
+    assert(viewing.getInputText().data() == text.data());
+    assert(viewing.get() == owning.get());
+    assert(viewing.getLcpArray() == owning.getLcpArray());
+
+    const std::string_view suffix = viewing.getNthSuffix(5);
+    assert(suffix.data() == text.data() + viewing.getPosition(4));
+    assert(suffix == owning.getNthSuffix(5));
+
+    const std::string_view pattern = std::string_view(text).substr(300, 5);
+    assert(viewing.searchSubstring(pattern) == owning.searchSubstring(std::string(pattern)));
+
+    assert(viewing.minLexRotation() == owning.minLexRotation());
+    const GADS::IndexType start = viewing.minLexRotationStart();
+    assert(viewing.minLexRotation() == text.substr(start) + text.substr(0, start));
+
+    // Suffix array over a mapped text file
+    const std::string path = "SuffixArrayUT.txt";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+    {
+        const GADS::SuffixArray mapped = GADS::SuffixArray::fromTextFile(path);
+        assert(mapped.getInputText() == text);
+        assert(mapped.get() == owning.get());
+        assert(mapped.lcp(10, 20) == owning.lcp(10, 20));
+    }
+    std::remove(path.c_str());
+
+    bool thrown = false;
+    try
+    {
+        GADS::SuffixArray::fromTextFile(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void testFindRange()
+{
+    const GADS::SuffixArray sa1("banana");
+    const auto range = sa1.findRange("ana");
+    assert(range.first == 1 && range.second == 3);
+    assert(sa1.count("a") == 3);
+    assert(sa1.count("nab") == 0);
+    assert(sa1.count("") == 6);
+
+    GADS::IndexVct positions(sa1.occurrences("na").begin(), sa1.occurrences("na").end());
+    std::sort(positions.begin(), positions.end());
+    assert(positions == GADS::IndexVct({ 2, 4 }));
+
+    // All lcp supports agree with direct search, including bytes above 127
+    // Repeated block with rare changes gives long matches of border suffixes
+    std::string text;
+    const std::string block = makeText(60, 2, 29);
+    while (text.size() < 3000)
+        text += block;
+    for (GADS::IndexType i = 0; i < text.size(); i += 97)
+        text[i] = '\xF0';
+
+    const GADS::LcpSupport supports[] = { GADS::LcpSupport::None, GADS::LcpSupport::SparseTable, GADS::LcpSupport::BlockSparseTable };
+    for (const auto support : supports)
+    {
+        const GADS::SuffixArray sa(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support));
+
+        for (GADS::IndexType len = 1; len < 200; len += (len < 40) ? 3 : 37)
+        {
+            for (GADS::IndexType start = 0; start + len < text.size(); start += 211)
+            {
+                std::string pattern = text.substr(start, len);
+                if (start % 2 == 1)
+                    pattern.back() = (pattern.back() == 'a') ? 'b' : '\xF0'; // Possibly absent pattern
+
+                GADS::IndexVct expected;
+                for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+                    expected.push_back(pos);
+
+                const auto occurrences = sa.occurrences(pattern);
+                GADS::IndexVct found(occurrences.begin(), occurrences.end());
+                std::sort(found.begin(), found.end());
+
+                assert(found == expected);
+                assert(sa.count(pattern) == expected.size());
+                assert(sa.indexValid(sa.searchSubstring(pattern)) == !expected.empty());
+            }
+        }
+    }
+
+    // Copies of a long prefix followed by different tails, borders and probes match the pattern along the prefix.
+    // With lcp support a probe compares again fewer symbols than the shortest skip, the rest of the pattern once.
+    const std::string prefix = makeText(1000, 4, 31);
+    std::string copies;
+    for (GADS::IndexType i = 0; i < 64; i++)
+        copies += prefix + makeText(8, 4, 37 + i) + '#';
+
+    for (const auto support : { GADS::LcpSupport::SparseTable, GADS::LcpSupport::BlockSparseTable })
+    {
+        const GADS::SuffixArray sa(copies, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support));
+        const std::string pattern = copies.substr(5 * (prefix.size() + 9), prefix.size() + 8);
+
+        GADS::IndexType compared = 0;
+        const auto found = sa.findRange(pattern, &compared);
+        assert(found.second - found.first == 1);
+        const GADS::IndexType probes = 17; // Binary search steps over the 64.6k suffixes, per bound
+        assert(compared <= 2 * (pattern.size() + probes * GADS::RangeMinimumQuery::BlockSize));
+    }
+}
+
+void testFindRanges()
+{
+    const std::string text = makeText(5000, 3, 31);
+    const GADS::SuffixArray sa(text);
+
+    // Patterns from the text, absent ones, duplicates and an empty one
+    GADS::GenericVector<std::string> storage;
+    for (GADS::IndexType i = 0; i < 600; i++)
+    {
+        std::string pattern = text.substr((i * 7919) % (text.size() - 50), 1 + i % 45);
+        if (i % 5 == 0)
+            pattern += 'z';
+        storage.push_back(pattern);
+    }
+    storage.push_back(storage[10]);
+    storage.push_back("");
+    for (GADS::IndexType len = 1; len < 30; len++) // Chain of extensions
+        storage.push_back(text.substr(1234, len));
+
+    const GADS::GenericVector<std::string_view> patterns(storage.begin(), storage.end());
+
+    GADS::ThreadPool pool(3);
+    const auto sequential = sa.findRanges(patterns);
+    const auto parallel = sa.findRanges(patterns, &pool);
+    assert(sequential.size() == patterns.size());
+
+    for (GADS::IndexType i = 0; i < patterns.size(); i++)
+    {
+        assert(sequential[i] == sa.findRange(patterns[i]));
+        assert(parallel[i] == sequential[i]);
+    }
+
+    assert(sa.findRanges({}).empty());
+}
+
+// Substring of a repeat found by the suffix array
+std::string repeatText(const GADS::SuffixArray& sa, const GADS::Repeat& repeat)
+{
+    return std::string(sa.getInputText().substr(sa.getPosition(repeat.lo), repeat.length));
+}
+
+void testRepeats()
+{
+    const GADS::SuffixArray sa1("banana");
+    const GADS::Repeat longest = sa1.longestRepeatedSubstring();
+    assert(longest.length == 3 && longest.count() == 2 && repeatText(sa1, longest) == "ana");
+    GADS::IndexVct positions(sa1.occurrences(longest).begin(), sa1.occurrences(longest).end());
+    std::sort(positions.begin(), positions.end());
+    assert(positions == GADS::IndexVct({ 1, 3 }));
+
+    // "a" and "ana" are maximal, "an" and "na" are always extended to "ana"
+    GADS::GenericVector<std::string> repeats;
+    for (const auto& repeat : sa1.maximalRepeats(1))
+        repeats.push_back(repeatText(sa1, repeat));
+    std::sort(repeats.begin(), repeats.end());
+    assert(repeats == GADS::GenericVector<std::string>({ "a", "ana" }));
+    assert(sa1.maximalRepeats(4).empty());
+
+    assert(GADS::SuffixArray("abc").longestRepeatedSubstring().length == 0);
+    assert(GADS::SuffixArray("").maximalRepeats(1).empty());
+    assert(GADS::SuffixArray("aaaa").maximalRepeats(0).size() == 3);
+
+    // Brute force over all substrings, with and without stored LCP array
+    for (unsigned seed = 1; seed <= 40; seed++)
+    {
+        const std::string text = makeText(10 + seed * 3 % 50, 2 + seed % 3, seed);
+        const GADS::LcpSupport support = (seed % 2) ? GADS::LcpSupport::None : GADS::LcpSupport::SparseTable;
+        const GADS::SuffixArray sa(text, GADS::SuffixArrayOptions(GADS::SuffixArrayConstruction::InducedSorting, support));
+
+        GADS::GenericVector< std::pair<std::string, GADS::IndexType> > expected; // Maximal repeats with counts
+        std::string longestExpected;
+        for (GADS::IndexType len = 1; len < text.size(); len++)
+        {
+            for (GADS::IndexType start = 0; start + len <= text.size(); start++)
+            {
+                const std::string sub = text.substr(start, len);
+                if (text.find(sub) != start)
+                    continue; // Counted at its first occurrence
+
+                GADS::IndexVct occ;
+                for (auto pos = text.find(sub); pos != std::string::npos; pos = text.find(sub, pos + 1))
+                    occ.push_back(pos);
+                if (occ.size() < 2)
+                    continue;
+
+                if (len > longestExpected.size() || (len == longestExpected.size() && sub < longestExpected))
+                    longestExpected = sub;
+
+                // Maximal if the occurrences differ in a preceding or following character or reach the text border
+                GADS::GenericSet<std::string> before;
+                GADS::GenericSet<std::string> after;
+                for (auto pos : occ)
+                {
+                    before.insert((pos == 0) ? std::string("^") + text : text.substr(pos - 1, 1));
+                    after.insert((pos + len == text.size()) ? std::string("$") + text : text.substr(pos + len, 1));
+                }
+                if (before.size() > 1 && after.size() > 1 && len >= 3)
+                    expected.push_back({ sub, occ.size() });
+            }
+        }
+
+        const GADS::Repeat lrs = sa.longestRepeatedSubstring();
+        assert(repeatText(sa, lrs) == longestExpected);
+        assert(lrs.count() == static_cast<GADS::IndexType>(std::count_if(sa.occurrences(lrs).begin(), sa.occurrences(lrs).end(),
+            [&](GADS::IndexType pos) { return text.compare(pos, lrs.length, longestExpected) == 0; })));
+        assert(lrs.count() == sa.count(longestExpected));
+
+        GADS::GenericVector< std::pair<std::string, GADS::IndexType> > found;
+        for (const auto& repeat : sa.maximalRepeats(3))
+            found.push_back({ repeatText(sa, repeat), repeat.count() });
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        assert(found == expected);
+    }
+}
+
+void testFMIndex()
+{
+    const GADS::FMIndex banana(GADS::SuffixArray("banana"), 2);
+    assert(banana.count("ana") == 2);
+    assert(banana.count("nab") == 0);
+    assert(banana.count("") == 6);
+    assert(banana.extract(1, 4) == "anan");
+    assert(banana.extract(4, 10) == "na");
+
+    GADS::IndexVct positions = banana.locate(std::string_view("an"));
+    std::sort(positions.begin(), positions.end());
+    assert(positions == GADS::IndexVct({ 1, 3 }));
+
+    // Agrees with the suffix array for various sample rates, including bytes 0 and above 127
+    std::string text = makeText(2500, 5, 37);
+    for (GADS::IndexType i = 0; i < text.size(); i += 101)
+        text[i] = (i % 2 == 0) ? '\0' : '\xE9';
+    const GADS::SuffixArray sa(text);
+
+    for (GADS::IndexType sampleRate : { 1, 7, 32 })
+    {
+        const GADS::FMIndex fm(sa, sampleRate);
+        assert(fm.size() == text.size());
+
+        for (GADS::IndexType order = 0; order < sa.size(); order += 13)
+            assert(fm.locate(order) == sa.getPosition(order));
+
+        for (GADS::IndexType len = 1; len < 30; len += 4)
+        {
+            for (GADS::IndexType start = 0; start + len < text.size(); start += 173)
+            {
+                std::string pattern = text.substr(start, len);
+                if (start % 3 == 0)
+                    pattern.back() = 'x'; // Absent pattern
+
+                const auto expected = sa.findRange(pattern);
+                assert(fm.count(pattern) == expected.second - expected.first);
+                if (expected.first < expected.second)
+                    assert(fm.findRange(pattern) == expected);
+                assert(fm.indexValid(fm.searchSubstring(pattern)) == (expected.first < expected.second));
+            }
+        }
+
+        for (GADS::IndexType pos = 0; pos <= text.size(); pos += 97)
+            assert(fm.extract(pos, 45) == text.substr(pos, 45));
+        assert(fm.extract(0, text.size()) == text);
+    }
+
+    // Degenerate texts
+    for (const std::string tiny : { "", "a", "aaaa" })
+    {
+        const GADS::FMIndex fm{ GADS::SuffixArray(tiny) };
+        assert(fm.count("a") == tiny.size());
+        assert(fm.extract(0, tiny.size()) == tiny);
+    }
+
+    // Compressed below the text size for natural alphabets
+    const std::string words = makeText(200000, 8, 41);
+    assert(GADS::FMIndex(GADS::SuffixArray(words)).memoryUsage() < words.size());
+}
+
+void testGeneralizedSuffixArray()
+{
+    const GADS::GenericVector<std::string> documents = { "banana", "ananas", "", "nab", "cabana" };
+    const GADS::GeneralizedSuffixArray gsa(documents);
+
+    assert(gsa.documentCount() == 5);
+    assert(gsa.size() == 21);
+    assert(gsa.document(1) == "ananas");
+    assert(gsa.document(2).empty());
+
+    assert(gsa.count("ana") == 5);
+    assert(gsa.count("anab") == 0); // Would cross from "banana" into "ananas" in plain concatenation
+    assert(gsa.count("ab") == 2);
+    assert(gsa.documentsContaining("na") == GADS::IndexVct({ 0, 1, 3, 4 }));
+    assert(gsa.documentsContaining("x").empty());
+
+    GADS::GenericVector<GADS::DocumentPosition> found = gsa.occurrences("nab");
+    assert(found.size() == 1 && found[0] == (GADS::DocumentPosition{ 3, 0 }));
+
+    const auto top = gsa.topDocuments<2>("an");
+    assert(top.size() == 2);
+    assert(top[0] == (GADS::DocumentFrequency{ 0, 2 })); // Ties with document 1 resolved by smaller id
+    assert(top[1] == (GADS::DocumentFrequency{ 1, 2 }));
+
+    // Agrees with direct search on many generated documents containing separator bytes
+    GADS::GenericVector<std::string> generated;
+    for (GADS::IndexType d = 0; d < 300; d++)
+    {
+        std::string doc = makeText(d % 37, 3, static_cast<unsigned>(d + 1));
+        if (d % 11 == 0 && !doc.empty())
+            doc[doc.size() / 2] = '\0';
+        generated.push_back(doc);
+    }
+    const GADS::GeneralizedSuffixArray many(generated);
+
+    const GADS::GenericVector<std::string> patterns = { "a", "ab", "cab", "bca", "aaa", std::string("a\0", 2), std::string("\0", 1) };
+    for (const auto& pattern : patterns)
+    {
+        GADS::GenericVector<GADS::DocumentFrequency> expected;
+        GADS::IndexType total = 0;
+        for (GADS::IndexType d = 0; d < generated.size(); d++)
+        {
+            GADS::IndexType frequency = 0;
+            for (auto pos = generated[d].find(pattern); pos != std::string::npos; pos = generated[d].find(pattern, pos + 1))
+                frequency++;
+            if (frequency > 0)
+                expected.push_back({ d, frequency });
+            total += frequency;
+        }
+
+        assert(many.count(pattern) == total);
+        assert(many.documentFrequencies(pattern) == expected);
+
+        for (const auto& occurrence : many.occurrences(pattern))
+            assert(many.document(occurrence.document).substr(occurrence.offset, pattern.size()) == pattern);
+
+        const auto best = many.topDocuments<5>(pattern);
+        std::sort(expected.begin(), expected.end(), [](const GADS::DocumentFrequency& a, const GADS::DocumentFrequency& b)
+            {
+                return GADS::DocumentFrequencyComparer()(b, a);
+            });
+        expected.resize(std::min<GADS::IndexType>(expected.size(), 5));
+        assert(best == expected);
+    }
+
+    assert(GADS::GeneralizedSuffixArray(GADS::GenericVector<std::string>()).count("a") == 0);
+
+    // Merge gives the same suffix order as building over all documents
+    for (GADS::IndexType split : { GADS::IndexType(0), GADS::IndexType(1), GADS::IndexType(150), GADS::IndexType(300) })
+    {
+        const GADS::GenericVector<std::string> older(generated.begin(), generated.begin() + split);
+        const GADS::GenericVector<std::string> newer(generated.begin() + split, generated.end());
+        const GADS::GeneralizedSuffixArray merged = GADS::GeneralizedSuffixArray::merge(GADS::GeneralizedSuffixArray(older), GADS::GeneralizedSuffixArray(newer));
+
+        assert(merged.documentCount() == many.documentCount());
+        assert(merged.size() == many.size());
+        for (GADS::IndexType order = 0; order < many.size(); order++)
+            assert(merged.getPosition(order) == many.getPosition(order));
+        assert(merged.documentFrequencies("ab") == many.documentFrequencies("ab"));
+    }
+}
+
+void testLongestCommonSubstring()
+{
+    const GADS::GeneralizedSuffixArray pair(GADS::GenericVector<std::string>({ "xabcdy", "zzabcdabq" }));
+    const GADS::CommonSubstring common = pair.longestCommonSubstring(2);
+    assert(common.length == 4);
+    assert(common.occurrences == GADS::GenericVector<GADS::DocumentPosition>({ { 0, 1 }, { 1, 2 } }));
+
+    // No match crosses a document boundary
+    const GADS::GeneralizedSuffixArray split(GADS::GenericVector<std::string>({ "ab", "ba", "b" }));
+    assert(split.longestCommonSubstring(2).length == 1);
+    assert(split.longestCommonSubstring(3).occurrences == GADS::GenericVector<GADS::DocumentPosition>({ { 0, 1 }, { 1, 0 }, { 2, 0 } }));
+    assert(GADS::GeneralizedSuffixArray(GADS::GenericVector<std::string>({ "ab", "cd" })).longestCommonSubstring(2).length == 0);
+
+    bool thrown = false;
+    try
+    {
+        split.longestCommonSubstring(4);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Brute force over substrings of generated documents containing separator bytes
+    for (unsigned seed = 1; seed <= 30; seed++)
+    {
+        GADS::GenericVector<std::string> documents;
+        for (GADS::IndexType d = 0; d < 2 + seed % 5; d++)
+        {
+            std::string doc = makeText(seed * 7 % 23 + d * 5, 2 + seed % 3, seed * 13 + static_cast<unsigned>(d));
+            if (d == 1 && !doc.empty())
+                doc[doc.size() / 2] = '\0';
+            documents.push_back(doc);
+        }
+        const GADS::GeneralizedSuffixArray gsa(documents);
+
+        for (GADS::IndexType minDocuments = 2; minDocuments <= documents.size(); minDocuments++)
+        {
+            std::string best;
+            for (const auto& doc : documents)
+            {
+                for (GADS::IndexType start = 0; start < doc.size(); start++)
+                {
+                    for (GADS::IndexType len = 1; start + len <= doc.size(); len++)
+                    {
+                        const std::string sub = doc.substr(start, len);
+                        const auto containing = std::count_if(documents.begin(), documents.end(),
+                            [&sub](const std::string& other) { return other.find(sub) != std::string::npos; });
+                        if (containing >= static_cast<std::ptrdiff_t>(minDocuments) && (len > best.size() || (len == best.size() && sub < best)))
+                            best = sub;
+                    }
+                }
+            }
+
+            GADS::GenericVector<GADS::DocumentPosition> expected;
+            for (GADS::IndexType d = 0; d < documents.size() && !best.empty(); d++)
+            {
+                const auto pos = documents[d].find(best);
+                if (pos != std::string::npos)
+                    expected.push_back({ d, pos });
+            }
+
+            const GADS::CommonSubstring found = gsa.longestCommonSubstring(minDocuments);
+            assert(found.length == best.size());
+            assert(found.occurrences == expected);
+        }
+    }
+}
+
+void testSegmentedSuffixArray()
+{
+    GADS::GenericVector<std::string> batches;
+    for (GADS::IndexType b = 0; b < 200; b++)
+    {
+        std::string batch = makeText((b * 7) % 53, 3, static_cast<unsigned>(b + 11));
+        if (b % 13 == 0 && !batch.empty())
+            batch[0] = '\0';
+        batches.push_back(batch);
+    }
+    const GADS::GeneralizedSuffixArray expected(batches);
+
+    auto verify = [&](const GADS::SegmentedSuffixArray& segmented)
+    {
+        assert(segmented.batchCount() == batches.size());
+        assert(segmented.size() == expected.size());
+        assert(segmented.batch(17) == batches[17]);
+
+        const GADS::GenericVector<std::string> patterns = { "a", "bc", "cab", "aaaa", std::string("\0", 1), "x" };
+        for (const auto& pattern : patterns)
+        {
+            assert(segmented.count(pattern) == expected.count(pattern));
+
+            GADS::GenericVector<GADS::DocumentPosition> found = expected.occurrences(pattern);
+            std::sort(found.begin(), found.end(), [](const GADS::DocumentPosition& a, const GADS::DocumentPosition& b)
+                {
+                    return std::make_pair(a.document, a.offset) < std::make_pair(b.document, b.offset);
+                });
+            assert(segmented.occurrences(pattern) == found);
+        }
+    };
+
+    // Merges inside append keep segment sizes decreasing by the merge factor
+    GADS::SegmentedSuffixArray synchronous;
+    for (GADS::IndexType b = 0; b < batches.size(); b++)
+        assert(synchronous.append(batches[b]) == b);
+    assert(synchronous.segmentCount() < 16);
+    verify(synchronous);
+
+    bool thrown = false;
+    try
+    {
+        synchronous.batch(batches.size());
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Background merges, queries run concurrently with them
+    GADS::ThreadPool pool(2);
+    GADS::SegmentedSuffixArray background(&pool);
+    for (const auto& batch : batches)
+    {
+        background.append(batch);
+        assert(background.count(std::string_view()) == background.size());
+    }
+    background.waitForMerges();
+    assert(background.segmentCount() < 16);
+    verify(background);
+
+    GADS::SegmentedSuffixArray unmerged(nullptr, 0);
+    for (const auto& batch : batches)
+        unmerged.append(batch);
+    assert(unmerged.segmentCount() == batches.size());
+    verify(unmerged);
 }
 
 int main()
@@ -126,6 +1053,21 @@ int main()
     testLcp();
     testSearchSubstring();
     testMiinLexRotation();
+    testMinimalRotation();
+    testInducedSorting();
+    testParallelConstruction();
+    testSymbolTypes();
+    testLcpSupport();
+    testIndexWidth();
+    testSaveLoad();
+    testNonOwningText();
+    testFindRange();
+    testFindRanges();
+    testRepeats();
+    testFMIndex();
+    testGeneralizedSuffixArray();
+    testLongestCommonSubstring();
+    testSegmentedSuffixArray();
 
     std::cout << "--- All suffix array tests executed ---" << std::endl;
 }
\ No newline at end of file